@@ -1,7 +1,55 @@
 #pragma once
 
+#include "iterator.hpp"
+#include "utility.hpp"
+#include <cstddef>
+#include <climits>
+#include <limits>
+#include <cstring>
+#include <functional>
+#include <memory>
+
 namespace ft
 {
+	/***********************************************
+		CONTIGUOUS RANGE DETECTION
+	***********************************************/
+
+	/*Strips ft::normal_iterator down to the iterator it wraps so that contiguous ranges can be recognised*/
+	template <typename Iterator>
+	struct niter_base_
+	{
+		typedef Iterator type;
+		static Iterator get(const Iterator& it) { return it; }
+	};
+
+	template <typename Iterator, typename Container>
+	struct niter_base_<ft::normal_iterator<Iterator, Container> >
+	{
+		typedef Iterator type;
+		static Iterator get(const ft::normal_iterator<Iterator, Container>& it) { return it.base(); }
+	};
+
+	/*Yields the cv-unqualified type @T points to, or void if @T is not a pointer*/
+	template <typename T>
+	struct pointee_
+	{ typedef void type; };
+
+	template <typename T>
+	struct pointee_<T*>
+	{ typedef typename ft::remove_cv<T>::type type; };
+
+	/*True if both iterators are (wrapped) pointers to the same integral type, 
+	so their ranges can be compared bytewise*/
+	template <typename Iterator_lhs, typename Iterator_rhs>
+	struct is_contiguous_integral_pair_
+	: public ft::bool_constant<
+		ft::is_integral<typename pointee_<typename niter_base_<Iterator_lhs>::type>::type>::value &&
+		ft::are_same<
+			typename pointee_<typename niter_base_<Iterator_lhs>::type>::type,
+			typename pointee_<typename niter_base_<Iterator_rhs>::type>::type>::value>
+	{};
+
 	/***********************************************
 		MODIFYING OPERATIONS
 	***********************************************/
@@ -81,12 +129,13 @@ namespace ft
 		return first;
 	}
 
-	/*Determines if two sets of elements are the same*/
+	/*Element by element comparison used by @equal for arbitrary iterators*/
 	template <typename InputIterator_lhs, typename InputIterator_rhs>
-	bool equal(
+	bool equal_(
 		InputIterator_lhs first, 
 		InputIterator_lhs last,
-		InputIterator_rhs to_compare_first)
+		InputIterator_rhs to_compare_first,
+		ft::false_type)
 	{
 		for (; first != last; ++first, ++to_compare_first)
 			if (!(*first == *to_compare_first))
@@ -94,13 +143,40 @@ namespace ft
 		return true;
 	}
 
-	/*Returns true if one range is lexicographically less than another*/
+	/*Contiguous integral ranges are equal exactly if their bytes are*/
+	template <typename Iterator_lhs, typename Iterator_rhs>
+	bool equal_(
+		Iterator_lhs first, 
+		Iterator_lhs last,
+		Iterator_rhs to_compare_first,
+		ft::true_type)
+	{
+		const std::size_t n = static_cast<std::size_t>(last - first);
+		if (n == 0)
+			return true;
+		return std::memcmp(niter_base_<Iterator_lhs>::get(first), niter_base_<Iterator_rhs>::get(to_compare_first), 
+			n * sizeof(*first)) == 0;
+	}
+
+	/*Determines if two sets of elements are the same*/
 	template <typename InputIterator_lhs, typename InputIterator_rhs>
-	bool lexicographical_compare(
+	bool equal(
+		InputIterator_lhs first, 
+		InputIterator_lhs last,
+		InputIterator_rhs to_compare_first)
+	{ 
+		return equal_(first, last, to_compare_first, 
+			is_contiguous_integral_pair_<InputIterator_lhs, InputIterator_rhs>());
+	}
+
+	/*Element by element comparison used by @lexicographical_compare for arbitrary iterators*/
+	template <typename InputIterator_lhs, typename InputIterator_rhs>
+	bool lexicographical_compare_(
 		InputIterator_lhs first, 
 		InputIterator_lhs last,
 		InputIterator_rhs to_compare_first,
-		InputIterator_rhs to_compare_last)
+		InputIterator_rhs to_compare_last,
+		ft::false_type)
 	{
 		for (; (first != last) && (to_compare_first != to_compare_last); ++first, ++to_compare_first)
 		{
@@ -111,4 +187,846 @@ namespace ft
 		}
 		return (first == last) && (to_compare_first != to_compare_last);
 	}
+
+	/*Contiguous integral ranges: memcmp orders unsigned bytes directly. 
+	Wider or signed types skip equal blocks with memcmp and compare only the block holding the first mismatch.*/
+	template <typename Iterator_lhs, typename Iterator_rhs>
+	bool lexicographical_compare_(
+		Iterator_lhs first, 
+		Iterator_lhs last,
+		Iterator_rhs to_compare_first,
+		Iterator_rhs to_compare_last,
+		ft::true_type)
+	{
+		typedef typename pointee_<typename niter_base_<Iterator_lhs>::type>::type	value_type;
+
+		const value_type* lhs = niter_base_<Iterator_lhs>::get(first);
+		const value_type* rhs = niter_base_<Iterator_rhs>::get(to_compare_first);
+		const std::size_t lhs_size = static_cast<std::size_t>(last - first);
+		const std::size_t rhs_size = static_cast<std::size_t>(to_compare_last - to_compare_first);
+		const std::size_t n = ft::min(lhs_size, rhs_size);
+		const bool unsigned_bytes = sizeof(value_type) == 1 && value_type(0) < value_type(-1);
+
+		if (unsigned_bytes)
+		{
+			const int result = (n == 0) ? 0 : std::memcmp(lhs, rhs, n);
+			if (result != 0)
+				return result < 0;
+			return lhs_size < rhs_size;
+		}
+		/*memcmp one cache line at a time, then locate the mismatch inside the differing line*/
+		const std::size_t block = 64 / sizeof(value_type);
+		std::size_t i = 0;
+		for (; i + block <= n; i += block)
+			if (std::memcmp(lhs + i, rhs + i, block * sizeof(value_type)) != 0)
+				break;
+		for (; i < n; ++i)
+			if (lhs[i] != rhs[i])
+				return lhs[i] < rhs[i];
+		return lhs_size < rhs_size;
+	}
+
+	/*Returns true if one range is lexicographically less than another*/
+	template <typename InputIterator_lhs, typename InputIterator_rhs>
+	bool lexicographical_compare(
+		InputIterator_lhs first, 
+		InputIterator_lhs last,
+		InputIterator_rhs to_compare_first,
+		InputIterator_rhs to_compare_last)
+	{
+		return lexicographical_compare_(first, last, to_compare_first, to_compare_last,
+			is_contiguous_integral_pair_<InputIterator_lhs, InputIterator_rhs>());
+	}
+
+	/***********************************************
+		HEAP OPERATIONS
+	***********************************************/
+
+	/*Moves @value down from @hole into the max heap [first, first + len) until the heap property holds*/
+	template <typename RandomIterator, typename Distance, typename T, typename Compare>
+	void adjust_heap_(RandomIterator first, Distance hole, Distance len, T value, Compare comp)
+	{
+		Distance child = 2 * hole + 1;
+		while (child < len)
+		{
+			if (child + 1 < len && comp(first[child], first[child + 1]))
+				++child;
+			if (!comp(value, first[child]))
+				break;
+			first[hole] = first[child];
+			hole = child;
+			child = 2 * hole + 1;
+		}
+		first[hole] = value;
+	}
+
+	/*Arranges the range [first, last) into a max heap with respect to @comp*/
+	template <typename RandomIterator, typename Compare>
+	void make_heap(RandomIterator first, RandomIterator last, Compare comp)
+	{
+		typedef typename ft::iterator_traits<RandomIterator>::difference_type	difference_type;
+
+		const difference_type len = last - first;
+		for (difference_type parent = len / 2; parent > 0;)
+		{
+			--parent;
+			adjust_heap_(first, parent, len, *(first + parent), comp);
+		}
+	}
+
+	/*Arranges the range [first, last) into a max heap*/
+	template <typename RandomIterator>
+	void make_heap(RandomIterator first, RandomIterator last)
+	{ ft::make_heap(first, last, std::less<typename ft::iterator_traits<RandomIterator>::value_type>());}
+
+	/*Turns the max heap [first, last) into a range sorted in ascending order with respect to @comp*/
+	template <typename RandomIterator, typename Compare>
+	void sort_heap(RandomIterator first, RandomIterator last, Compare comp)
+	{
+		typedef typename ft::iterator_traits<RandomIterator>::difference_type	difference_type;
+		typedef typename ft::iterator_traits<RandomIterator>::value_type		value_type;
+
+		for (difference_type len = last - first; len > 1;)
+		{
+			--len;
+			value_type value = first[len];
+			first[len] = *first;
+			adjust_heap_(first, difference_type(0), len, value, comp);
+		}
+	}
+
+	/*Turns the max heap [first, last) into a range sorted in ascending order*/
+	template <typename RandomIterator>
+	void sort_heap(RandomIterator first, RandomIterator last)
+	{ ft::sort_heap(first, last, std::less<typename ft::iterator_traits<RandomIterator>::value_type>());}
+
+	/***********************************************
+		SORTING OPERATIONS
+	***********************************************/
+
+	/*Tuning constants of the pattern-defeating quicksort behind @sort*/
+	enum
+	{
+		sort_insertion_threshold_ = 24,
+		sort_ninther_threshold_ = 128,
+		sort_partial_insertion_limit_ = 8,
+		sort_block_size_ = 64
+	};
+
+	/*Comparators for which the branchless block partition pays off: the built-in orderings of arithmetic types*/
+	template <typename T, typename Compare>
+	struct is_branchless_compare_ : public false_type {};
+
+	template <typename T>
+	struct is_branchless_compare_<T, std::less<T> > : public bool_constant<ft::is_arithmetic<T>::value> {};
+
+	template <typename T>
+	struct is_branchless_compare_<T, std::greater<T> > : public bool_constant<ft::is_arithmetic<T>::value> {};
+
+	/*Swaps the elements @a and @b point to*/
+	template <typename Iterator>
+	inline void iter_swap_(Iterator a, Iterator b)
+	{ ft::swap(*a, *b);}
+
+	/*Compare-exchange, the building block of the sorting networks below*/
+	template <typename Iterator, typename Compare>
+	inline void sort2_(Iterator a, Iterator b, Compare comp)
+	{
+		if (comp(*b, *a))
+			iter_swap_(a, b);
+	}
+
+	/*Sorting network for three elements*/
+	template <typename Iterator, typename Compare>
+	inline void sort3_(Iterator a, Iterator b, Iterator c, Compare comp)
+	{
+		sort2_(a, b, comp);
+		sort2_(b, c, comp);
+		sort2_(a, b, comp);
+	}
+
+	/*Sorting network for four elements*/
+	template <typename Iterator, typename Compare>
+	inline void sort4_(Iterator a, Iterator b, Iterator c, Iterator d, Compare comp)
+	{
+		sort2_(a, b, comp);
+		sort2_(c, d, comp);
+		sort2_(a, c, comp);
+		sort2_(b, d, comp);
+		sort2_(b, c, comp);
+	}
+
+	/*Sorts ranges of up to four elements with a sorting network. Returns false for longer ranges*/
+	template <typename RandomIterator, typename Compare>
+	inline bool sort_network_(RandomIterator first, RandomIterator last, Compare comp)
+	{
+		switch (last - first)
+		{
+			case 0:
+			case 1:
+				return true;
+			case 2:
+				sort2_(first, first + 1, comp);
+				return true;
+			case 3:
+				sort3_(first, first + 1, first + 2, comp);
+				return true;
+			case 4:
+				sort4_(first, first + 1, first + 2, first + 3, comp);
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	/*Sorts [first, last) by insertion*/
+	template <typename RandomIterator, typename Compare>
+	void insertion_sort_(RandomIterator first, RandomIterator last, Compare comp)
+	{
+		typedef typename ft::iterator_traits<RandomIterator>::value_type	value_type;
+
+		if (first == last)
+			return ;
+		for (RandomIterator cur = first + 1; cur != last; ++cur)
+		{
+			RandomIterator sift = cur;
+			RandomIterator sift_1 = cur - 1;
+			if (comp(*sift, *sift_1))
+			{
+				value_type tmp = *sift;
+				do { *sift-- = *sift_1;}
+				while (sift != first && comp(tmp, *--sift_1));
+				*sift = tmp;
+			}
+		}
+	}
+
+	/*Insertion sort without the lower bound check. 
+	Requires an element in front of @first that is not greater than any element of the range.*/
+	template <typename RandomIterator, typename Compare>
+	void unguarded_insertion_sort_(RandomIterator first, RandomIterator last, Compare comp)
+	{
+		typedef typename ft::iterator_traits<RandomIterator>::value_type	value_type;
+
+		if (first == last)
+			return ;
+		for (RandomIterator cur = first + 1; cur != last; ++cur)
+		{
+			RandomIterator sift = cur;
+			RandomIterator sift_1 = cur - 1;
+			if (comp(*sift, *sift_1))
+			{
+				value_type tmp = *sift;
+				do { *sift-- = *sift_1;}
+				while (comp(tmp, *--sift_1));
+				*sift = tmp;
+			}
+		}
+	}
+
+	/*Insertion sort that gives up once more than sort_partial_insertion_limit_ elements were moved.
+	Returns true if the range ended up sorted.*/
+	template <typename RandomIterator, typename Compare>
+	bool partial_insertion_sort_(RandomIterator first, RandomIterator last, Compare comp)
+	{
+		typedef typename ft::iterator_traits<RandomIterator>::value_type	value_type;
+
+		if (first == last)
+			return true;
+		std::size_t limit = 0;
+		for (RandomIterator cur = first + 1; cur != last; ++cur)
+		{
+			RandomIterator sift = cur;
+			RandomIterator sift_1 = cur - 1;
+			if (comp(*sift, *sift_1))
+			{
+				value_type tmp = *sift;
+				do { *sift-- = *sift_1;}
+				while (sift != first && comp(tmp, *--sift_1));
+				*sift = tmp;
+				limit += static_cast<std::size_t>(cur - sift);
+			}
+			if (limit > sort_partial_insertion_limit_)
+				return false;
+		}
+		return true;
+	}
+
+	/*Swaps the elements marked in the offset blocks of the branchless partition. 
+	Equally sized blocks use plain swaps, otherwise a cyclic permutation saves a third of the moves.*/
+	template <typename RandomIterator>
+	inline void swap_offsets_(RandomIterator first, RandomIterator last,
+		const unsigned char* offsets_l, const unsigned char* offsets_r, std::size_t num, bool use_swaps)
+	{
+		typedef typename ft::iterator_traits<RandomIterator>::value_type	value_type;
+
+		if (use_swaps)
+		{
+			for (std::size_t i = 0; i < num; ++i)
+				iter_swap_(first + offsets_l[i], last - offsets_r[i]);
+		}
+		else if (num > 0)
+		{
+			RandomIterator l = first + offsets_l[0];
+			RandomIterator r = last - offsets_r[0];
+			value_type tmp(*l);
+			*l = *r;
+			for (std::size_t i = 1; i < num; ++i)
+			{
+				l = first + offsets_l[i];
+				*r = *l;
+				r = last - offsets_r[i];
+				*l = *r;
+			}
+			*r = tmp;
+		}
+	}
+
+	/*Partitions [first, last) around the pivot *first, elements equal to the pivot go to the right.
+	Returns the final pivot position and whether the range was already partitioned.*/
+	template <typename RandomIterator, typename Compare>
+	ft::pair<RandomIterator, bool> partition_right_(RandomIterator begin, RandomIterator end, Compare comp, ft::false_type)
+	{
+		typedef typename ft::iterator_traits<RandomIterator>::value_type	value_type;
+
+		value_type pivot(*begin);
+		RandomIterator first = begin;
+		RandomIterator last = end;
+
+		while (comp(*++first, pivot));
+		if (first - 1 == begin)
+			while (first < last && !comp(*--last, pivot));
+		else
+			while (!comp(*--last, pivot));
+
+		const bool already_partitioned = first >= last;
+		while (first < last)
+		{
+			iter_swap_(first, last);
+			while (comp(*++first, pivot));
+			while (!comp(*--last, pivot));
+		}
+		RandomIterator pivot_pos = first - 1;
+		*begin = *pivot_pos;
+		*pivot_pos = pivot;
+		return ft::make_pair(pivot_pos, already_partitioned);
+	}
+
+	/*Same as above, but comparison results are gathered into offset blocks first and the swaps done afterwards,
+	which keeps the comparison loop free of unpredictable branches.*/
+	template <typename RandomIterator, typename Compare>
+	ft::pair<RandomIterator, bool> partition_right_(RandomIterator begin, RandomIterator end, Compare comp, ft::true_type)
+	{
+		typedef typename ft::iterator_traits<RandomIterator>::value_type	value_type;
+
+		value_type pivot(*begin);
+		RandomIterator first = begin;
+		RandomIterator last = end;
+
+		while (comp(*++first, pivot));
+		if (first - 1 == begin)
+			while (first < last && !comp(*--last, pivot));
+		else
+			while (!comp(*--last, pivot));
+
+		const bool already_partitioned = first >= last;
+		if (!already_partitioned)
+		{
+			iter_swap_(first, last);
+			++first;
+
+			unsigned char offsets_l[sort_block_size_];
+			unsigned char offsets_r[sort_block_size_];
+			RandomIterator offsets_l_base = first;
+			RandomIterator offsets_r_base = last;
+			std::size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+			while (first < last)
+			{
+				const std::size_t num_unknown = static_cast<std::size_t>(last - first);
+				const std::size_t left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+				const std::size_t right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+
+				const std::size_t left_count = ft::min<std::size_t>(left_split, sort_block_size_);
+				for (std::size_t i = 0; i < left_count; ++i, ++first)
+				{
+					offsets_l[num_l] = static_cast<unsigned char>(i);
+					num_l += !comp(*first, pivot);
+				}
+				const std::size_t right_count = ft::min<std::size_t>(right_split, sort_block_size_);
+				for (std::size_t i = 0; i < right_count;)
+				{
+					offsets_r[num_r] = static_cast<unsigned char>(++i);
+					num_r += comp(*--last, pivot);
+				}
+
+				const std::size_t num = ft::min(num_l, num_r);
+				swap_offsets_(offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r, num, num_l == num_r);
+				num_l -= num;
+				num_r -= num;
+				start_l += num;
+				start_r += num;
+				if (num_l == 0)
+				{
+					start_l = 0;
+					offsets_l_base = first;
+				}
+				if (num_r == 0)
+				{
+					start_r = 0;
+					offsets_r_base = last;
+				}
+			}
+			if (num_l)
+			{
+				while (num_l--)
+					iter_swap_(offsets_l_base + offsets_l[start_l + num_l], --last);
+				first = last;
+			}
+			if (num_r)
+			{
+				while (num_r--)
+				{
+					iter_swap_(offsets_r_base - offsets_r[start_r + num_r], first);
+					++first;
+				}
+				last = first;
+			}
+		}
+		RandomIterator pivot_pos = first - 1;
+		*begin = *pivot_pos;
+		*pivot_pos = pivot;
+		return ft::make_pair(pivot_pos, already_partitioned);
+	}
+
+	/*Partitions [first, last) around the pivot *first, elements equal to the pivot go to the left. 
+	Used when the pivot equals its predecessor, so the whole equal run is finished in one step.*/
+	template <typename RandomIterator, typename Compare>
+	RandomIterator partition_left_(RandomIterator begin, RandomIterator end, Compare comp)
+	{
+		typedef typename ft::iterator_traits<RandomIterator>::value_type	value_type;
+
+		value_type pivot(*begin);
+		RandomIterator first = begin;
+		RandomIterator last = end;
+
+		while (comp(pivot, *--last));
+		if (last + 1 == end)
+			while (first < last && !comp(pivot, *++first));
+		else
+			while (!comp(pivot, *++first));
+
+		while (first < last)
+		{
+			iter_swap_(first, last);
+			while (comp(pivot, *--last));
+			while (!comp(pivot, *++first));
+		}
+		RandomIterator pivot_pos = last;
+		*begin = *pivot_pos;
+		*pivot_pos = pivot;
+		return pivot_pos;
+	}
+
+	/*Pattern-defeating quicksort main loop. Falls back to heapsort after @bad_allowed unbalanced partitions.*/
+	template <typename RandomIterator, typename Compare, typename Branchless>
+	void pdqsort_loop_(RandomIterator begin, RandomIterator end, Compare comp, int bad_allowed, bool leftmost, Branchless branchless)
+	{
+		typedef typename ft::iterator_traits<RandomIterator>::difference_type	difference_type;
+
+		while (true)
+		{
+			const difference_type size = end - begin;
+			if (size < sort_insertion_threshold_)
+			{
+				if (sort_network_(begin, end, comp))
+					return ;
+				if (leftmost)
+					insertion_sort_(begin, end, comp);
+				else
+					unguarded_insertion_sort_(begin, end, comp);
+				return ;
+			}
+
+			const difference_type s2 = size / 2;
+			if (size > sort_ninther_threshold_)
+			{
+				sort3_(begin, begin + s2, end - 1, comp);
+				sort3_(begin + 1, begin + (s2 - 1), end - 2, comp);
+				sort3_(begin + 2, begin + (s2 + 1), end - 3, comp);
+				sort3_(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+				iter_swap_(begin, begin + s2);
+			}
+			else
+				sort3_(begin + s2, begin, end - 1, comp);
+
+			if (!leftmost && !comp(*(begin - 1), *begin))
+			{
+				begin = partition_left_(begin, end, comp) + 1;
+				continue ;
+			}
+
+			ft::pair<RandomIterator, bool> part = partition_right_(begin, end, comp, branchless);
+			RandomIterator pivot_pos = part.first;
+			const difference_type l_size = pivot_pos - begin;
+			const difference_type r_size = end - (pivot_pos + 1);
+
+			if (l_size < size / 8 || r_size < size / 8)
+			{
+				if (--bad_allowed == 0)
+				{
+					ft::make_heap(begin, end, comp);
+					ft::sort_heap(begin, end, comp);
+					return ;
+				}
+				if (l_size >= sort_insertion_threshold_)
+				{
+					iter_swap_(begin, begin + l_size / 4);
+					iter_swap_(pivot_pos - 1, pivot_pos - l_size / 4);
+					if (l_size > sort_ninther_threshold_)
+					{
+						iter_swap_(begin + 1, begin + (l_size / 4 + 1));
+						iter_swap_(begin + 2, begin + (l_size / 4 + 2));
+						iter_swap_(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+						iter_swap_(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+					}
+				}
+				if (r_size >= sort_insertion_threshold_)
+				{
+					iter_swap_(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+					iter_swap_(end - 1, end - r_size / 4);
+					if (r_size > sort_ninther_threshold_)
+					{
+						iter_swap_(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+						iter_swap_(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+						iter_swap_(end - 2, end - (1 + r_size / 4));
+						iter_swap_(end - 3, end - (2 + r_size / 4));
+					}
+				}
+			}
+			else if (part.second 
+				&& partial_insertion_sort_(begin, pivot_pos, comp)
+				&& partial_insertion_sort_(pivot_pos + 1, end, comp))
+				return ;
+
+			pdqsort_loop_(begin, pivot_pos, comp, bad_allowed, leftmost, branchless);
+			begin = pivot_pos + 1;
+			leftmost = false;
+		}
+	}
+
+	/*Sorts the elements in the range [first, last) with respect to @comp. The order of equal elements is not preserved.
+	Pattern-defeating quicksort: sorted, reversed and few-unique inputs take linear time, the worst case is O(n log n).*/
+	template <typename RandomIterator, typename Compare>
+	void sort(RandomIterator first, RandomIterator last, Compare comp)
+	{
+		typedef typename ft::iterator_traits<RandomIterator>::value_type	value_type;
+
+		if (last - first < 2)
+			return ;
+		int bad_allowed = 0;
+		for (std::size_t size = static_cast<std::size_t>(last - first); size > 1; size >>= 1)
+			++bad_allowed;
+		pdqsort_loop_(first, last, comp, bad_allowed, true, is_branchless_compare_<value_type, Compare>());
+	}
+
+	/*Sorts the elements in the range [first, last) in ascending order.*/
+	template <typename RandomIterator>
+	void sort(RandomIterator first, RandomIterator last)
+	{ ft::sort(first, last, std::less<typename ft::iterator_traits<RandomIterator>::value_type>());}
+
+	/*Rearranges [first, last) so that [first, middle) holds the smallest elements in sorted order.
+	The order of the remaining elements is unspecified.*/
+	template <typename RandomIterator, typename Compare>
+	void partial_sort(RandomIterator first, RandomIterator middle, RandomIterator last, Compare comp)
+	{
+		typedef typename ft::iterator_traits<RandomIterator>::difference_type	difference_type;
+		typedef typename ft::iterator_traits<RandomIterator>::value_type		value_type;
+
+		ft::make_heap(first, middle, comp);
+		const difference_type len = middle - first;
+		for (RandomIterator it = middle; it < last; ++it)
+		{
+			if (comp(*it, *first))
+			{
+				value_type value = *it;
+				*it = *first;
+				adjust_heap_(first, difference_type(0), len, value, comp);
+			}
+		}
+		ft::sort_heap(first, middle, comp);
+	}
+
+	/*Rearranges [first, last) so that [first, middle) holds the smallest elements in ascending order.*/
+	template <typename RandomIterator>
+	void partial_sort(RandomIterator first, RandomIterator middle, RandomIterator last)
+	{ ft::partial_sort(first, middle, last, std::less<typename ft::iterator_traits<RandomIterator>::value_type>());}
+
+	/*Scratch copy of a range used by @stable_sort. Owns and releases its storage.*/
+	template <typename T>
+	class sort_buffer_
+	{
+		public:
+			template <typename InputIterator>
+			sort_buffer_(InputIterator first, std::size_t n)
+			:alloc_(), data_(alloc_.allocate(n)), size_(n)
+			{
+				try
+				{ std::uninitialized_copy(first, first + n, data_);}
+				catch (...)
+				{
+					alloc_.deallocate(data_, size_);
+					throw;
+				}
+			}
+
+			~sort_buffer_()
+			{
+				for (std::size_t i = 0; i < size_; ++i)
+					alloc_.destroy(data_ + i);
+				alloc_.deallocate(data_, size_);
+			}
+
+			T* data() const { return data_;}
+
+		private:
+			sort_buffer_(const sort_buffer_&);
+			sort_buffer_& operator=(const sort_buffer_&);
+
+			std::allocator<T>	alloc_;
+			T*					data_;
+			std::size_t			size_;
+	};
+
+	/*Merges the sorted ranges [src + l, src + l_end) and [src + r, src + r_end) into @dst starting at @out.
+	Ties are taken from the left range.*/
+	template <typename SourceIterator, typename DestIterator, typename Compare>
+	void merge_ranges_(SourceIterator src, std::size_t l, std::size_t l_end, std::size_t r, std::size_t r_end,
+		DestIterator dst, std::size_t out, Compare comp)
+	{
+		while (l < l_end && r < r_end)
+		{
+			if (comp(src[r], src[l]))
+				dst[out++] = src[r++];
+			else
+				dst[out++] = src[l++];
+		}
+		while (l < l_end)
+			dst[out++] = src[l++];
+		while (r < r_end)
+			dst[out++] = src[r++];
+	}
+
+	/*Merges neighbouring sorted runs of length @step from [src, src + len) into @dst. Ties are taken from the left run.*/
+	template <typename SourceIterator, typename DestIterator, typename Compare>
+	void merge_runs_(SourceIterator src, std::size_t len, DestIterator dst, std::size_t step, Compare comp)
+	{
+		for (std::size_t run = 0; run < len; run += 2 * step)
+		{
+			const std::size_t middle = ft::min(run + step, len);
+			ft::merge_ranges_(src, run, middle, middle, ft::min(run + 2 * step, len), dst, run, comp);
+		}
+	}
+
+	/*Sorts the elements in the range [first, last) with respect to @comp, preserving the order of equal elements.
+	Bottom-up merge sort over insertion sorted runs, alternating between the range and one scratch buffer.*/
+	template <typename RandomIterator, typename Compare>
+	void stable_sort(RandomIterator first, RandomIterator last, Compare comp)
+	{
+		typedef typename ft::iterator_traits<RandomIterator>::value_type	value_type;
+
+		const std::size_t len = static_cast<std::size_t>(last - first);
+		const std::size_t run = 32;
+		for (std::size_t i = 0; i < len; i += run)
+			insertion_sort_(first + i, first + ft::min(i + run, len), comp);
+		if (len <= run)
+			return ;
+
+		sort_buffer_<value_type> buffer(first, len);
+		bool in_buffer = false;
+		for (std::size_t step = run; step < len; step *= 2)
+		{
+			if (in_buffer)
+				merge_runs_(buffer.data(), len, first, step, comp);
+			else
+				merge_runs_(first, len, buffer.data(), step, comp);
+			in_buffer = !in_buffer;
+		}
+		if (in_buffer)
+			ft::copy(buffer.data(), buffer.data() + len, first);
+	}
+
+	/*Sorts the elements in the range [first, last) in ascending order, preserving the order of equal elements.*/
+	template <typename RandomIterator>
+	void stable_sort(RandomIterator first, RandomIterator last)
+	{ ft::stable_sort(first, last, std::less<typename ft::iterator_traits<RandomIterator>::value_type>());}
+
+	/*Maps an integral key onto the unsigned type of its width, so that unsigned order equals the key order.
+	Signed keys get their sign bit flipped.*/
+	template <typename Key>
+	inline typename ft::make_unsigned<Key>::type radix_key_(Key key)
+	{
+		typedef typename ft::make_unsigned<Key>::type	bits_type;
+
+		bits_type bits = static_cast<bits_type>(key);
+		if (std::numeric_limits<Key>::is_signed)
+			bits = static_cast<bits_type>(bits ^ (static_cast<bits_type>(1) << (sizeof(Key) * CHAR_BIT - 1)));
+		return bits;
+	}
+
+	/*One counting sort pass of @radix_sort: scatters [src, src + len) into @dst by the byte at @shift.
+	@offsets holds the histogram of that byte and is consumed.*/
+	template <typename SourceIterator, typename DestIterator, typename KeyExtractor>
+	void radix_pass_(SourceIterator src, std::size_t len, DestIterator dst, KeyExtractor key, 
+		std::size_t shift, std::size_t* offsets)
+	{
+		std::size_t sum = 0;
+		for (std::size_t bucket = 0; bucket < 256; ++bucket)
+		{
+			const std::size_t count = offsets[bucket];
+			offsets[bucket] = sum;
+			sum += count;
+		}
+		for (std::size_t i = 0; i < len; ++i)
+			dst[offsets[(radix_key_(key(src[i])) >> shift) & 0xff]++] = src[i];
+	}
+
+	/*Sorts [first, last) in ascending order of the integral @key of each element, preserving the order of equal keys.
+	LSD radix sort over bytes: one pass builds all histograms, bytes shared by every element are skipped.
+	The scratch buffer is only set up once a byte actually differs.*/
+	template <typename RandomIterator, typename KeyExtractor>
+	typename ft::enable_if<ft::is_integral<typename KeyExtractor::result_type>::value>::type
+	radix_sort(RandomIterator first, RandomIterator last, KeyExtractor key)
+	{
+		typedef typename ft::iterator_traits<RandomIterator>::value_type	value_type;
+		typedef typename KeyExtractor::result_type							key_type;
+		typedef typename ft::make_unsigned<key_type>::type					bits_type;
+
+		const std::size_t len = static_cast<std::size_t>(last - first);
+		if (len < 2)
+			return ;
+
+		std::size_t counts[sizeof(key_type)][256];
+		std::memset(counts, 0, sizeof(counts));
+		for (RandomIterator it = first; it != last; ++it)
+		{
+			const bits_type bits = radix_key_(key(*it));
+			for (std::size_t digit = 0; digit < sizeof(key_type); ++digit)
+				++counts[digit][(bits >> (digit * CHAR_BIT)) & 0xff];
+		}
+
+		const bits_type first_bits = radix_key_(key(*first));
+		std::size_t digit = 0;
+		while (digit < sizeof(key_type) && counts[digit][(first_bits >> (digit * CHAR_BIT)) & 0xff] == len)
+			++digit;
+		if (digit == sizeof(key_type))
+			return ;
+
+		sort_buffer_<value_type> buffer(first, len);
+		bool in_buffer = false;
+		for (; digit < sizeof(key_type); ++digit)
+		{
+			const std::size_t shift = digit * CHAR_BIT;
+			if (counts[digit][(first_bits >> shift) & 0xff] == len)
+				continue ;
+			if (in_buffer)
+				radix_pass_(buffer.data(), len, first, key, shift, counts[digit]);
+			else
+				radix_pass_(first, len, buffer.data(), key, shift, counts[digit]);
+			in_buffer = !in_buffer;
+		}
+		if (in_buffer)
+			ft::copy(buffer.data(), buffer.data() + len, first);
+	}
+
+	/*Sorts the integral elements of [first, last) in ascending order with an LSD radix sort.*/
+	template <typename RandomIterator>
+	typename ft::enable_if<ft::is_integral<typename ft::iterator_traits<RandomIterator>::value_type>::value>::type
+	radix_sort(RandomIterator first, RandomIterator last)
+	{ ft::radix_sort(first, last, ft::identity<typename ft::iterator_traits<RandomIterator>::value_type>());}
+
+	/***********************************************
+		BINARY SEARCH OPERATIONS
+	***********************************************/
+
+	/*Default ordering of the search functions: operator< between an element and the searched value*/
+	struct iter_less_
+	{
+		template <typename T1, typename T2>
+		bool operator()(const T1& lhs, const T2& rhs) const { return lhs < rhs; }
+	};
+
+	/*Hints the cache to load the line holding @address. Has no effect on compilers without the builtin.*/
+	inline void prefetch_(const void* address)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		__builtin_prefetch(address);
+#else
+		(void) address;
+#endif
+	}
+
+	/*Returns an iterator to the first element of the sorted range [first, last) that is not less than @value.
+	Halves the range with a conditional move instead of a branch and prefetches both possible next midpoints.*/
+	template <typename RandomIterator, typename T, typename Compare>
+	RandomIterator lower_bound(RandomIterator first, RandomIterator last, const T& value, Compare comp)
+	{
+		typedef typename ft::iterator_traits<RandomIterator>::difference_type	difference_type;
+
+		difference_type len = last - first;
+		if (len == 0)
+			return first;
+		while (len > 1)
+		{
+			const difference_type half = len / 2;
+			prefetch_(&*(first + half / 2));
+			prefetch_(&*(first + (half + half / 2)));
+			first = comp(first[half], value) ? first + half : first;
+			len -= half;
+		}
+		return comp(*first, value) ? first + 1 : first;
+	}
+
+	/*Returns an iterator to the first element of the sorted range [first, last) that is not less than @value.*/
+	template <typename RandomIterator, typename T>
+	RandomIterator lower_bound(RandomIterator first, RandomIterator last, const T& value)
+	{ return ft::lower_bound(first, last, value, iter_less_());}
+
+	/*Returns an iterator to the first element of the sorted range [first, last) that is greater than @value.*/
+	template <typename RandomIterator, typename T, typename Compare>
+	RandomIterator upper_bound(RandomIterator first, RandomIterator last, const T& value, Compare comp)
+	{
+		typedef typename ft::iterator_traits<RandomIterator>::difference_type	difference_type;
+
+		difference_type len = last - first;
+		if (len == 0)
+			return first;
+		while (len > 1)
+		{
+			const difference_type half = len / 2;
+			prefetch_(&*(first + half / 2));
+			prefetch_(&*(first + (half + half / 2)));
+			first = !comp(value, first[half]) ? first + half : first;
+			len -= half;
+		}
+		return !comp(value, *first) ? first + 1 : first;
+	}
+
+	/*Returns an iterator to the first element of the sorted range [first, last) that is greater than @value.*/
+	template <typename RandomIterator, typename T>
+	RandomIterator upper_bound(RandomIterator first, RandomIterator last, const T& value)
+	{ return ft::upper_bound(first, last, value, iter_less_());}
+
+	/*Checks if an element equivalent to @value appears within the sorted range [first, last).*/
+	template <typename RandomIterator, typename T, typename Compare>
+	bool binary_search(RandomIterator first, RandomIterator last, const T& value, Compare comp)
+	{
+		first = ft::lower_bound(first, last, value, comp);
+		return first != last && !comp(value, *first);
+	}
+
+	/*Checks if an element equal to @value appears within the sorted range [first, last).*/
+	template <typename RandomIterator, typename T>
+	bool binary_search(RandomIterator first, RandomIterator last, const T& value)
+	{ return ft::binary_search(first, last, value, iter_less_());}
 }
\ No newline at end of file
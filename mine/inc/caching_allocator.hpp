@@ -0,0 +1,462 @@
+#pragma once
+
+#include "algorithm.hpp"
+#include <pthread.h>
+#include <cstddef>
+#include <limits>
+#include <new>
+
+namespace ft
+{
+	/***********************************************
+		BLOCK CACHE
+	***********************************************/
+
+	/*Entry of the list of all block caches in use, so that a trim reaches the caches of every block size*/
+	struct block_cache_link_
+	{
+		std::size_t			(*trim)();
+		block_cache_link_*	next;
+	};
+
+	inline pthread_mutex_t& block_cache_links_mutex_()
+	{
+		static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+		return mutex;
+	}
+
+	inline block_cache_link_*& block_cache_links_()
+	{
+		static block_cache_link_* links = 0;
+		return links;
+	}
+
+	/*Adds @link to the list of block caches. Links are never removed, caches live until the program ends.*/
+	inline void link_block_cache_(block_cache_link_* link)
+	{
+		pthread_mutex_lock(&block_cache_links_mutex_());
+		link->next = block_cache_links_();
+		block_cache_links_() = link;
+		pthread_mutex_unlock(&block_cache_links_mutex_());
+	}
+
+	/*Trims every block cache in use and returns the number of bytes released*/
+	inline std::size_t trim_block_caches_()
+	{
+		std::size_t released = 0;
+		pthread_mutex_lock(&block_cache_links_mutex_());
+		try
+		{
+			for (block_cache_link_* link = block_cache_links_(); link != 0; link = link->next)
+				released += link->trim();
+		}
+		catch (...)
+		{
+			pthread_mutex_unlock(&block_cache_links_mutex_());
+			throw;
+		}
+		pthread_mutex_unlock(&block_cache_links_mutex_());
+		return released;
+	}
+
+	/* Free blocks of @BlockSize bytes, shared by all caching_allocators whose node types round to that size.
+	Every thread owns a private free list and only touches the global depot to exchange whole batches of blocks,
+	so the mutex is taken once per batch_size allocations instead of once per node.
+	A block may be freed by any thread: it simply joins the free list of the thread that frees it.
+	Idle blocks wait in the depot for the next thread to need them, until trim() hands the chunks whose blocks
+	are all idle back to the system.*/
+	template <std::size_t BlockSize>
+	class block_cache_
+	{
+		private:
+			/*Free block. The first word links blocks of one batch. The first block of a batch in the depot
+			also links to the next batch and records the length of its own.*/
+			struct block_
+			{
+				block_*			next;
+				block_*			next_batch;
+				std::size_t		batch_length;
+			};
+
+			/*Header of a chunk, kept in the block in front of the batch_size blocks carved from it*/
+			struct chunk_
+			{
+				chunk_*			next;
+				std::size_t		free_blocks;
+			};
+
+			struct thread_cache_
+			{
+				block_*			free_list;
+				std::size_t		count;
+			};
+
+			/*Global store of full batches and source of new ones*/
+			struct depot_
+			{
+				pthread_mutex_t		mutex;
+				pthread_key_t		key;
+				block_*				batches;
+				chunk_*				chunks;
+				std::size_t			chunk_count;
+				block_cache_link_	link;
+
+				depot_(): batches(0), chunks(0), chunk_count(0)
+				{
+					pthread_mutex_init(&mutex, 0);
+					pthread_key_create(&key, &block_cache_::thread_exit_);
+					link.trim = &block_cache_::trim;
+					link_block_cache_(&link);
+				}
+			};
+
+			/*Blocks moved between a thread cache and the depot at once*/
+			static const std::size_t batch_size = 64;
+
+		public:
+			/*Returns a block from the free list of the calling thread, refilled from the depot if empty*/
+			static void* allocate()
+			{
+				thread_cache_* cache = local_cache_();
+				if (cache->free_list == 0)
+				{
+					cache->free_list = pop_batch_();
+					cache->count = cache->free_list->batch_length;
+				}
+				block_* block = cache->free_list;
+				cache->free_list = block->next;
+				--cache->count;
+				return block;
+			}
+
+			/*Puts @p on the free list of the calling thread. Once the list holds two batches, one goes to the depot.*/
+			static void deallocate(void* p)
+			{
+				thread_cache_* cache = local_cache_();
+				block_* block = static_cast<block_*>(p);
+				block->next = cache->free_list;
+				cache->free_list = block;
+				if (++cache->count >= 2 * batch_size)
+				{
+					block_* batch = cache->free_list;
+					block_* last = batch;
+					for (std::size_t i = 1; i < batch_size; ++i)
+						last = last->next;
+					cache->free_list = last->next;
+					last->next = 0;
+					cache->count -= batch_size;
+					push_batch_(batch, batch_size);
+				}
+			}
+
+			/*Frees every chunk whose blocks are all idle in the depot and returns the number of bytes released.
+			The free list of the calling thread goes to the depot first; blocks cached by other threads keep
+			their chunks alive. Takes time linear in the number of idle blocks, under the depot mutex.*/
+			static std::size_t trim()
+			{
+				thread_cache_* cache = local_cache_();
+				while (cache->free_list != 0)
+				{
+					block_* batch = split_batch_(cache->free_list);
+					push_batch_(batch, batch->batch_length);
+				}
+				cache->count = 0;
+
+				depot_& depot = depot_instance_();
+				std::size_t released = 0;
+				pthread_mutex_lock(&depot.mutex);
+				try
+				{ released = release_idle_chunks_(depot);}
+				catch (...)
+				{
+					pthread_mutex_unlock(&depot.mutex);
+					throw;
+				}
+				pthread_mutex_unlock(&depot.mutex);
+				return released;
+			}
+
+		private:
+			static depot_& depot_instance_()
+			{
+				static depot_ depot;
+				return depot;
+			}
+
+			static thread_cache_*& thread_slot_()
+			{
+				static __thread thread_cache_* cache = 0;
+				return cache;
+			}
+
+			/*Returns the cache of the calling thread, creating it on first use*/
+			static thread_cache_* local_cache_()
+			{
+				thread_cache_*& cache = thread_slot_();
+				if (cache == 0)
+				{
+					cache = new thread_cache_();
+					cache->free_list = 0;
+					cache->count = 0;
+					pthread_setspecific(depot_instance_().key, cache);
+				}
+				return cache;
+			}
+
+			/*Takes a batch from the depot, or carves one from a new chunk if the depot is empty*/
+			static block_* pop_batch_()
+			{
+				depot_& depot = depot_instance_();
+				pthread_mutex_lock(&depot.mutex);
+				block_* batch = depot.batches;
+				if (batch != 0)
+					depot.batches = batch->next_batch;
+				pthread_mutex_unlock(&depot.mutex);
+				if (batch != 0)
+					return batch;
+				char* memory = static_cast<char*>(::operator new((batch_size + 1) * BlockSize));
+				char* blocks = memory + BlockSize;
+				for (std::size_t i = 0; i < batch_size; ++i)
+					reinterpret_cast<block_*>(blocks + i * BlockSize)->next
+						= i + 1 < batch_size ? reinterpret_cast<block_*>(blocks + (i + 1) * BlockSize) : 0;
+				batch = reinterpret_cast<block_*>(blocks);
+				batch->batch_length = batch_size;
+				chunk_* chunk = reinterpret_cast<chunk_*>(memory);
+				pthread_mutex_lock(&depot.mutex);
+				chunk->next = depot.chunks;
+				depot.chunks = chunk;
+				++depot.chunk_count;
+				pthread_mutex_unlock(&depot.mutex);
+				return batch;
+			}
+
+			/*Hands a null terminated list of @length blocks to the depot*/
+			static void push_batch_(block_* batch, std::size_t length)
+			{
+				depot_& depot = depot_instance_();
+				batch->batch_length = length;
+				pthread_mutex_lock(&depot.mutex);
+				batch->next_batch = depot.batches;
+				depot.batches = batch;
+				pthread_mutex_unlock(&depot.mutex);
+			}
+
+			/*Cuts up to batch_size blocks off the front of @list, which is advanced past them.
+			Returns the cut off, null terminated batch; its length is stored in batch_length.*/
+			static block_* split_batch_(block_*& list)
+			{
+				block_* batch = list;
+				block_* last = batch;
+				std::size_t length = 1;
+				for (; length < batch_size && last->next != 0; ++length)
+					last = last->next;
+				list = last->next;
+				last->next = 0;
+				batch->batch_length = length;
+				return batch;
+			}
+
+			/*Returns the chunk of @block, given the chunk headers sorted by address*/
+			static chunk_* chunk_of_(block_* block, chunk_** first, chunk_** last)
+			{ return *(ft::upper_bound(first, last, reinterpret_cast<chunk_*>(block)) - 1); }
+
+			/*Counts the idle blocks of every chunk, rebuilds the batches of the depot without the blocks of
+			the chunks that are idle as a whole and frees those. The depot mutex must be held.*/
+			static std::size_t release_idle_chunks_(depot_& depot)
+			{
+				if (depot.chunk_count == 0)
+					return 0;
+				chunk_** sorted = static_cast<chunk_**>(::operator new(depot.chunk_count * sizeof(chunk_*)));
+				std::size_t n = 0;
+				for (chunk_* chunk = depot.chunks; chunk != 0; chunk = chunk->next, ++n)
+				{
+					chunk->free_blocks = 0;
+					sorted[n] = chunk;
+				}
+				ft::sort(sorted, sorted + n);
+				for (block_* batch = depot.batches; batch != 0; batch = batch->next_batch)
+					for (block_* block = batch; block != 0; block = block->next)
+						++chunk_of_(block, sorted, sorted + n)->free_blocks;
+
+				block_* kept = 0;
+				for (block_* batch = depot.batches; batch != 0; )
+				{
+					block_* next_batch = batch->next_batch;
+					for (block_* block = batch; block != 0; )
+					{
+						block_* next = block->next;
+						if (chunk_of_(block, sorted, sorted + n)->free_blocks != batch_size)
+						{
+							block->next = kept;
+							kept = block;
+						}
+						block = next;
+					}
+					batch = next_batch;
+				}
+				::operator delete(sorted);
+				depot.batches = 0;
+				while (kept != 0)
+				{
+					block_* batch = split_batch_(kept);
+					batch->next_batch = depot.batches;
+					depot.batches = batch;
+				}
+
+				std::size_t released = 0;
+				for (chunk_** link = &depot.chunks; *link != 0; )
+				{
+					chunk_* chunk = *link;
+					if (chunk->free_blocks == batch_size)
+					{
+						*link = chunk->next;
+						--depot.chunk_count;
+						::operator delete(chunk);
+						released += (batch_size + 1) * BlockSize;
+					}
+					else
+						link = &chunk->next;
+				}
+				return released;
+			}
+
+			/*Returns the free blocks of an exiting thread to the depot, the remainder as a shorter batch*/
+			static void thread_exit_(void* argument)
+			{
+				thread_cache_* cache = static_cast<thread_cache_*>(argument);
+				thread_slot_() = 0;
+				while (cache->free_list != 0)
+				{
+					block_* batch = split_batch_(cache->free_list);
+					push_batch_(batch, batch->batch_length);
+				}
+				delete cache;
+			}
+	};
+
+	/***********************************************
+		CACHING ALLOCATOR
+	***********************************************/
+
+	/* ft::caching_allocator serves single object allocations, i.e. the nodes of map and set, from per-thread
+	free lists of equally sized blocks, and everything else from operator new. Threads that churn their own
+	containers then allocate without contending on a lock. Needs -pthread.*/
+	template <typename T>
+	class caching_allocator
+	{
+		public:
+			typedef T					value_type;
+			typedef T*					pointer;
+			typedef const T*			const_pointer;
+			typedef T&					reference;
+			typedef const T&			const_reference;
+			typedef std::size_t			size_type;
+			typedef std::ptrdiff_t		difference_type;
+
+			template <typename U>
+			struct rebind
+			{ typedef caching_allocator<U> other; };
+
+		private:
+			/*Granularity of the block size: the pointer size, or the alignment of @T if that is stricter.
+			Blocks are carved back to back from chunks of operator new, so every block keeps this alignment
+			as long as it does not exceed that of operator new.*/
+			static const std::size_t block_align = __alignof__(T) > sizeof(void*) ? __alignof__(T) : sizeof(void*);
+
+			/*Size of the blocks for one @T: a multiple of block_align with room for the free list links*/
+			static const std::size_t block_size = ((sizeof(T) < 3 * sizeof(void*) ? 3 * sizeof(void*) : sizeof(T))
+				+ block_align - 1) / block_align * block_align;
+
+			typedef block_cache_<block_size>	cache_type;
+
+		public:
+			/***********************************************
+				Constructors
+			***********************************************/
+
+			/*Default constructor. The allocator is stateless*/
+			caching_allocator() {}
+
+			/*Copy constructor*/
+			caching_allocator(const caching_allocator&) {}
+
+			/*Converting constructor used by rebind*/
+			template <typename U>
+			caching_allocator(const caching_allocator<U>&) {}
+
+			/***********************************************
+				DESTRUCTORS
+			***********************************************/
+
+			/*default destructor*/
+			~caching_allocator() {}
+
+			/***********************************************
+				ADDRESS
+			***********************************************/
+
+			pointer address(reference x) const { return &x; }
+
+			const_pointer address(const_reference x) const { return &x; }
+
+			/***********************************************
+				ALLOCATION
+			***********************************************/
+
+			/*Allocates uninitialized storage for @n objects of type @T. Single objects come from the thread cache.*/
+			pointer allocate(size_type n, const void* = 0)
+			{
+				if (n == 1)
+					return static_cast<pointer>(cache_type::allocate());
+				if (n > max_size())
+					throw std::bad_alloc();
+				return static_cast<pointer>(::operator new(n * sizeof(T)));
+			}
+
+			/*Deallocates the storage referenced by @p, which must have been obtained by allocate(@n).
+			Any thread may free a block, not only the one that allocated it.*/
+			void deallocate(pointer p, size_type n)
+			{
+				if (n == 1)
+					cache_type::deallocate(p);
+				else
+					::operator delete(p);
+			}
+
+			/*Returns the largest number of objects that can be requested from allocate*/
+			size_type max_size() const
+			{ return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+			/*Hands the memory of idle blocks back to the system: frees every chunk whose blocks are all free and
+			returns the number of bytes released. Covers the block caches of all types, so the nodes a container
+			allocates through a rebound allocator are included. Blocks still on the free list of another thread
+			keep their chunk.*/
+			static size_type trim()
+			{ return ft::trim_block_caches_(); }
+
+			/***********************************************
+				CONSTRUCTION
+			***********************************************/
+
+			/*Copy constructs an object of type @T at @p*/
+			void construct(pointer p, const_reference value)
+			{ ::new(static_cast<void*>(p)) T(value); }
+
+			/*Calls the destructor of the object at @p*/
+			void destroy(pointer p)
+			{ p->~T(); }
+	};
+
+	/***********************************************
+		NON-MEMBER FUNCTIONS
+	***********************************************/
+
+	/*caching_allocators are stateless, any instance can free memory of any other*/
+	template <typename T1, typename T2>
+	inline bool operator==(const caching_allocator<T1>&, const caching_allocator<T2>&)
+	{ return true; }
+
+	template <typename T1, typename T2>
+	inline bool operator!=(const caching_allocator<T1>&, const caching_allocator<T2>&)
+	{ return false; }
+}
@@ -0,0 +1,356 @@
+#pragma once
+#include "compact_tree.hpp"
+#include "map.hpp"
+#include "utility.hpp"
+#include <stdexcept>
+
+namespace ft
+{
+	/* ft::compact_map has the interface of ft::map, but keeps its elements in a compact_tree: one contiguous arena
+	of nodes linked by 32-bit indices. Meant for large maps of small keys and values, where it needs about half
+	the memory of ft::map. Iterators survive insertions; references to elements do not survive growth of the arena.*/
+	template <typename Key, typename T, typename Compare = std::less<Key>,
+	typename Allocator = std::allocator< ft::pair<const Key, T> > >
+	class compact_map
+	{
+		public:
+			typedef Key									  								key_type;
+			typedef T																	mapped_type;
+			typedef ft::pair<const key_type, mapped_type>								value_type;
+			typedef Compare								  								key_compare;
+			typedef Allocator															allocator_type;
+			typedef typename allocator_type::reference									reference;
+			typedef typename allocator_type::const_reference							const_reference;
+			typedef typename allocator_type::pointer									pointer;
+			typedef typename allocator_type::const_pointer								const_pointer;
+			typedef typename allocator_type::size_type									size_type;
+			typedef typename allocator_type::difference_type 							difference_type;
+
+		private:
+			typedef map_value_type_compare<key_type, value_type, key_compare>			value_type_compare;
+			typedef ft::compact_tree<value_type, value_type_compare, allocator_type>	tree_type;
+
+		public:
+			typedef typename tree_type::iterator										iterator;
+			typedef typename tree_type::const_iterator		 							const_iterator;
+			typedef typename tree_type::reverse_iterator								reverse_iterator;
+			typedef typename tree_type::const_reverse_iterator							const_reverse_iterator;
+
+		public:
+			/*Function object that compares objects of type value_type
+			by comparing of the first components of the pairs.*/
+			class value_compare
+			{
+				friend class compact_map;
+
+				public:
+					typedef value_type 	first_argument_type;
+					typedef value_type 	second_argument_type;
+					typedef bool		result_type;
+
+				protected:
+					key_compare			comp_;
+					value_compare(key_compare c): comp_(c) {};
+
+				public:
+					bool operator()(const value_type& lhs, const value_type& rhs) const
+					{ return comp_(lhs.first, rhs.first);}
+			};
+
+			compact_map(
+				const key_compare& comp = key_compare(),
+				const allocator_type& alloc = allocator_type())
+				:tree_(value_type_compare(comp), alloc){}
+
+			template <class InputIterator>
+			compact_map(InputIterator first,
+				InputIterator last,
+				const key_compare& comp = key_compare(),
+				const allocator_type& alloc = allocator_type())
+				:tree_(value_type_compare(comp), alloc)
+			{ insert(first, last); }
+
+			compact_map(const compact_map& other): tree_(other.tree_) {}
+
+			~compact_map() {}
+
+			compact_map& operator=(const compact_map& other)
+			{
+				tree_ = other.tree_;
+				return *this;
+			}
+
+		private:
+			tree_type tree_;
+
+		public:
+
+			/***********************************************
+				ELEMENT ACCESS
+			***********************************************/
+
+			/*Returns a reference to the mapped value of the element with key equivalent to key.*/
+			mapped_type& at(const key_type& key)
+			{
+				iterator it = find(key);
+				if (it == end())
+					throw std::out_of_range("key not found");
+				return it->second;
+			}
+
+			/*Returns a read-only reference to the mapped value of the element with key equivalent to key.*/
+			const mapped_type& at(const key_type& key) const
+			{
+				const_iterator it = find(key);
+				if (it == end())
+					throw std::out_of_range("key not found");
+				return it->second;
+			}
+
+			/*Returns a reference to the value that is mapped to a key equivalent to key,
+			inserting if such key does not already exist.*/
+			mapped_type& operator[](const Key& key)
+			{ return try_emplace(key).first->second; }
+
+			/***********************************************
+				ITERATORS
+			***********************************************/
+
+			/*Returns an iterator to the first element of the map.*/
+			iterator begin()
+			{ return tree_.begin();}
+
+			/*Returns an read-only iterator to the first element of the map. */
+			const_iterator begin() const
+			{ return tree_.begin();}
+
+			/*Returns an iterator to the element following the last element of the map.*/
+			iterator end()
+			{ return tree_.end();}
+
+			/*Returns an read-only iterator to the element following the last element of the map. */
+			const_iterator end() const
+			{ return tree_.end();}
+
+			/*Returns a reverse iterator to the first element of the reversed map.*/
+			reverse_iterator rbegin()
+			{ return reverse_iterator(end());}
+
+			/*Returns a read-only reverse iterator to the first element of the reversed map.*/
+			const_reverse_iterator rbegin() const
+			{ return const_reverse_iterator(end());}
+
+			/*Returns a reverse iterator to the element following the last element of the reversed map.*/
+			reverse_iterator rend()
+			{ return reverse_iterator(begin());}
+
+			/*Returns a read-only reverse iterator to the element following the last element of the reversed map. */
+			const_reverse_iterator rend() const
+			{ return const_reverse_iterator(begin());}
+
+			/***********************************************
+				CAPACITY
+			***********************************************/
+
+			/*Checks if the container has no elements*/
+			bool empty() const
+			{return tree_.empty(); }
+
+			/*Returns the number of elements in the container*/
+			size_type size() const
+			{ return tree_.size(); }
+
+			/*Returns the maximum number of elements the container is able to hold*/
+			size_type max_size() const
+			{ return tree_.max_size(); }
+
+			/*Makes room for @n elements. Until the map holds more, references to its elements stay valid.*/
+			void reserve(size_type n)
+			{ tree_.reserve(n); }
+
+			/*Returns the number of elements the map can hold without growing its arena*/
+			size_type capacity() const
+			{ return tree_.capacity(); }
+
+			/***********************************************
+				MODIFIERS
+			***********************************************/
+
+			/*Erases all elements from the container. The arena keeps its capacity.*/
+			void clear()
+			{ tree_.clear(); }
+
+			/*Inserts element @val into the container, there is no element with equivalent key.*/
+			ft::pair<iterator, bool> insert(const value_type& val)
+			{ return tree_.insert(val); }
+
+			/*Inserts elements from range [first, last) */
+			template <class InputIterator>
+			void insert(InputIterator first, InputIterator last)
+			{
+				while (first != last)
+				{
+					tree_.insert(*first);
+					++first;
+				}
+			}
+
+			/*Inserts @value like insert(value). The hint @pos is ignored: the tree is always searched from the root.*/
+			iterator insert(iterator pos, const value_type& value)
+			{
+				(void) pos;
+				return tree_.insert(value).first;
+			}
+
+			/*Inserts a value-initialized element for @key unless the key already exists.
+			The map is searched once and no value is constructed if the key is found.*/
+			ft::pair<iterator, bool> try_emplace(const key_type& key)
+			{
+				typename tree_type::insert_position pos = tree_.find_position(key);
+
+				if (pos.found())
+					return ft::make_pair(iterator(&tree_, pos.node), false);
+				return ft::make_pair(tree_.insert_at(pos, value_type(key, mapped_type())), true);
+			}
+
+			/*Inserts an element for @key with the mapped value constructed from @arg unless the key already exists.
+			The map is searched once and @arg is left unused if the key is found.*/
+			template <class Arg>
+			ft::pair<iterator, bool> try_emplace(const key_type& key, const Arg& arg)
+			{
+				typename tree_type::insert_position pos = tree_.find_position(key);
+
+				if (pos.found())
+					return ft::make_pair(iterator(&tree_, pos.node), false);
+				return ft::make_pair(tree_.insert_at(pos, value_type(key, mapped_type(arg))), true);
+			}
+
+			/*Assigns @obj to the element with key @key, inserting it if the key does not exist yet.
+			Returns the element and whether it was inserted. The map is searched once.*/
+			template <class M>
+			ft::pair<iterator, bool> insert_or_assign(const key_type& key, const M& obj)
+			{
+				typename tree_type::insert_position pos = tree_.find_position(key);
+
+				if (pos.found())
+				{
+					tree_.value_at(pos).second = obj;
+					return ft::make_pair(iterator(&tree_, pos.node), false);
+				}
+				return ft::make_pair(tree_.insert_at(pos, value_type(key, obj)), true);
+			}
+
+			/*Removes the element at pos*/
+			iterator erase(iterator pos)
+			{ return tree_.erase(pos); }
+
+			/*Removes the elements in the range [first, last)*/
+			iterator erase(iterator first, iterator last)
+			{
+				while (first != last)
+					first = erase(first);
+				return first;
+			}
+
+			/*Removes the element with the key equivalent to key*/
+			size_type erase(const key_type& key)
+			{
+				iterator node = find(key);
+
+				if (node == end())
+					return 0;
+				tree_.erase(node);
+				return 1;
+			}
+
+			/*Exchanges the contents of the container with those of other*/
+			void swap(compact_map& other)
+			{ tree_.swap(other.tree_); }
+
+			/***********************************************
+				Lookup
+			***********************************************/
+
+			/*Returns the number of elements with key that compares equivalent to the specified argument.*/
+			size_type count(const key_type& key) const
+			{ return tree_.find(key) == end() ? 0 : 1; }
+
+			/*Finds an element with key equivalent to key.*/
+			iterator find(const key_type& key)
+			{ return tree_.find(key); }
+
+			/*Finds an element with key equivalent to key.*/
+			const_iterator find(const key_type& key) const
+			{ return tree_.find(key); }
+
+			/*Returns a range containing all elements with the given key in the container.*/
+			ft::pair<iterator,iterator> equal_range(const key_type& key)
+			{ return tree_.equal_range(key); }
+
+			/*Returns a range containing all elements with the given key in the container.*/
+			ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+			{ return tree_.equal_range(key); }
+
+			/*Returns an iterator to the first element whose key is not less than @key.*/
+			iterator lower_bound(const key_type& key)
+			{ return tree_.lower_bound(key); }
+
+			const_iterator lower_bound(const key_type& key) const
+			{ return tree_.lower_bound(key); }
+
+			/*Returns an iterator to the first element whose key is greater than @key.*/
+			iterator upper_bound(const key_type& key)
+			{ return tree_.upper_bound(key); }
+
+			const_iterator upper_bound(const key_type& key) const
+			{ return tree_.upper_bound(key); }
+
+			/***********************************************
+				OBSERVERS
+			***********************************************/
+
+			/*Returns the function that compares keys*/
+			key_compare key_comp() const
+			{ return tree_.value_comp().key_comp(); }
+
+			value_compare value_comp() const
+			{ return value_compare(key_comp()); }
+
+			allocator_type get_allocator() const
+			{ return tree_.get_allocator(); }
+	};
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	inline bool operator==(const compact_map<Key, T, Compare, Allocator>& lhs,
+						const compact_map<Key, T, Compare, Allocator>& rhs)
+	{ return (lhs.size() == rhs.size()) && ft::equal(lhs.begin(), lhs.end(), rhs.begin());}
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	inline bool operator!=(const compact_map<Key, T, Compare, Allocator>& lhs,
+						const compact_map<Key, T, Compare, Allocator>& rhs)
+	{ return !(lhs == rhs);}
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	inline bool operator<(const compact_map<Key, T, Compare, Allocator>& lhs,
+						const compact_map<Key, T, Compare, Allocator>& rhs)
+	{ return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());}
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	inline bool operator<=(const compact_map<Key, T, Compare, Allocator>& lhs,
+						const compact_map<Key, T, Compare, Allocator>& rhs)
+	{ return !(rhs < lhs);}
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	inline bool operator>(const compact_map<Key, T, Compare, Allocator>& lhs,
+						const compact_map<Key, T, Compare, Allocator>& rhs)
+	{ return rhs < lhs;}
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	inline bool operator>=(const compact_map<Key, T, Compare, Allocator>& lhs,
+						const compact_map<Key, T, Compare, Allocator>& rhs)
+	{return !(lhs < rhs);}
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	inline void swap(compact_map<Key, T, Compare, Allocator>& x, compact_map<Key, T, Compare, Allocator>& y)
+	{x.swap(y);}
+}
@@ -0,0 +1,241 @@
+#pragma once
+#include "compact_tree.hpp"
+#include "utility.hpp"
+
+namespace ft
+{
+	/* ft::compact_set has the interface of ft::set, but keeps its elements in a compact_tree: one contiguous arena
+	of nodes linked by 32-bit indices. Meant for large sets of small keys, where it needs about half the memory
+	of ft::set. Iterators survive insertions; references to elements do not survive growth of the arena.*/
+	template <typename Key, typename Compare = std::less<Key>, typename Allocator = std::allocator< Key > >
+	class compact_set
+	{
+		public:
+			typedef Key																key_type;
+			typedef Key																value_type;
+			typedef Compare															key_compare;
+			typedef Compare															value_compare;
+			typedef Allocator														allocator_type;
+			typedef typename allocator_type::reference								reference;
+			typedef typename allocator_type::const_reference						const_reference;
+			typedef typename allocator_type::pointer								pointer;
+			typedef typename allocator_type::const_pointer							const_pointer;
+			typedef typename allocator_type::size_type								size_type;
+			typedef typename allocator_type::difference_type						difference_type;
+
+		private:
+			typedef ft::compact_tree<value_type, value_compare, allocator_type>		tree_type;
+
+		public:
+			typedef typename tree_type::const_iterator								iterator;
+			typedef typename tree_type::const_iterator								const_iterator;
+			typedef typename tree_type::const_reverse_iterator						reverse_iterator;
+			typedef typename tree_type::const_reverse_iterator						const_reverse_iterator;
+
+		public:
+
+			compact_set(
+				const key_compare& comp = key_compare(),
+				const allocator_type& alloc = allocator_type())
+				:tree_(comp, alloc){}
+
+			template <class InputIterator>
+			compact_set(InputIterator first,
+				InputIterator last,
+				const key_compare& comp = key_compare(),
+				const allocator_type& alloc = allocator_type())
+				:tree_(comp, alloc)
+			{ insert(first, last); }
+
+			compact_set(const compact_set& other): tree_(other.tree_) {}
+
+			~compact_set() {}
+
+			compact_set& operator=(const compact_set& other)
+			{
+				tree_ = other.tree_;
+				return *this;
+			}
+
+		private:
+			tree_type tree_;
+
+		public:
+
+			/***********************************************
+				ITERATORS
+			***********************************************/
+
+			/*Returns an iterator to the first element of the set.*/
+			iterator begin() const
+			{ return tree_.begin();}
+
+			/*Returns an iterator to the element following the last element of the set.*/
+			iterator end() const
+			{ return tree_.end();}
+
+			/*Returns a reverse iterator to the first element of the reversed set.*/
+			reverse_iterator rbegin() const
+			{ return reverse_iterator(end());}
+
+			/*Returns a reverse iterator to the element following the last element of the reversed set.*/
+			reverse_iterator rend() const
+			{ return reverse_iterator(begin());}
+
+			/***********************************************
+				CAPACITY
+			***********************************************/
+
+			/*Checks if the container has no elements*/
+			bool empty() const
+			{return tree_.empty(); }
+
+			/*Returns the number of elements in the container*/
+			size_type size() const
+			{ return tree_.size(); }
+
+			/*Returns the maximum number of elements the container is able to hold*/
+			size_type max_size() const
+			{ return tree_.max_size(); }
+
+			/*Makes room for @n elements. Until the set holds more, references to its elements stay valid.*/
+			void reserve(size_type n)
+			{ tree_.reserve(n); }
+
+			/*Returns the number of elements the set can hold without growing its arena*/
+			size_type capacity() const
+			{ return tree_.capacity(); }
+
+			/***********************************************
+				MODIFIERS
+			***********************************************/
+
+			/*Erases all elements from the container. The arena keeps its capacity.*/
+			void clear()
+			{ tree_.clear(); }
+
+			/*Inserts element @val into the container, there is no element with equivalent key.*/
+			ft::pair<iterator, bool> insert(const value_type& val)
+			{
+				ft::pair<typename tree_type::iterator, bool> result = tree_.insert(val);
+				return ft::make_pair(iterator(result.first), result.second);
+			}
+
+			/*Inserts elements from range [first, last) */
+			template <class InputIterator>
+			void insert(InputIterator first, InputIterator last)
+			{
+				while (first != last)
+				{
+					tree_.insert(*first);
+					++first;
+				}
+			}
+
+			/*Inserts @value like insert(value). The hint @pos is ignored: the tree is always searched from the root.*/
+			iterator insert(iterator pos, const value_type& value)
+			{
+				(void) pos;
+				return tree_.insert(value).first;
+			}
+
+			/*Removes the element at pos*/
+			iterator erase(iterator pos)
+			{ return tree_.erase(pos); }
+
+			/*Removes the elements in the range [first, last)*/
+			iterator erase(iterator first, iterator last)
+			{
+				while (first != last)
+					first = erase(first);
+				return first;
+			}
+
+			/*Removes the element with the key equivalent to key*/
+			size_type erase(const key_type& key)
+			{
+				iterator node = find(key);
+
+				if (node == end())
+					return 0;
+				tree_.erase(node);
+				return 1;
+			}
+
+			/*Exchanges the contents of the container with those of other*/
+			void swap(compact_set& other)
+			{ tree_.swap(other.tree_); }
+
+			/***********************************************
+				Lookup
+			***********************************************/
+
+			/*Returns the number of elements with key that compares equivalent to the specified argument.*/
+			size_type count(const key_type& key) const
+			{ return tree_.find(key) == end() ? 0 : 1; }
+
+			/*Finds an element with key equivalent to key.*/
+			iterator find(const key_type& key) const
+			{ return tree_.find(key); }
+
+			/*Returns a range containing all elements with the given key in the container.*/
+			ft::pair<iterator, iterator> equal_range(const key_type& key) const
+			{ return tree_.equal_range(key); }
+
+			/*Returns an iterator to the first element that is not less than @key.*/
+			iterator lower_bound(const key_type& key) const
+			{ return tree_.lower_bound(key); }
+
+			/*Returns an iterator to the first element that is greater than @key.*/
+			iterator upper_bound(const key_type& key) const
+			{ return tree_.upper_bound(key); }
+
+			/***********************************************
+				OBSERVERS
+			***********************************************/
+
+			/*Returns the function that compares keys*/
+			key_compare key_comp() const
+			{ return tree_.value_comp(); }
+
+			value_compare value_comp() const
+			{ return tree_.value_comp(); }
+
+			allocator_type get_allocator() const
+			{ return tree_.get_allocator(); }
+	};
+
+	template <typename Key, typename Compare, typename Allocator>
+	inline bool operator==(const compact_set<Key, Compare, Allocator>& lhs,
+							const compact_set<Key, Compare, Allocator>& rhs)
+	{ return (lhs.size() == rhs.size()) && ft::equal(lhs.begin(), lhs.end(), rhs.begin()); }
+
+	template <typename Key, typename Compare, typename Allocator>
+	inline bool operator!=(const compact_set<Key, Compare, Allocator>& lhs,
+						const compact_set<Key, Compare, Allocator>& rhs)
+	{ return !(lhs == rhs); }
+
+	template <typename Key, typename Compare, typename Allocator>
+	inline bool operator<(const compact_set<Key, Compare, Allocator>& lhs,
+						const compact_set<Key, Compare, Allocator>& rhs)
+	{ return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
+
+	template <typename Key, typename Compare, typename Allocator>
+	inline bool operator<=(const compact_set<Key, Compare, Allocator>& lhs,
+						const compact_set<Key, Compare, Allocator>& rhs)
+	{ return !(rhs < lhs); }
+
+	template <typename Key, typename Compare, typename Allocator>
+	inline bool operator>(const compact_set<Key, Compare, Allocator>& lhs,
+						const compact_set<Key, Compare, Allocator>& rhs)
+	{ return rhs < lhs; }
+
+	template <typename Key, typename Compare, typename Allocator>
+	inline bool operator>=(const compact_set<Key, Compare, Allocator>& lhs,
+						const compact_set<Key, Compare, Allocator>& rhs)
+	{ return !(lhs < rhs); }
+
+	template <typename Key, typename Compare, typename Allocator>
+	inline void swap(compact_set<Key, Compare, Allocator>& x, compact_set<Key, Compare, Allocator>& y)
+	{ x.swap(y); }
+}
@@ -0,0 +1,674 @@
+#pragma once
+
+#include "iterator.hpp"
+#include "rbt_balance.hpp"
+#include "rbt_node.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+#include <limits>
+#include <new>
+#include <stdexcept>
+
+namespace ft
+{
+	/***********************************************
+		COMPACT NODE
+	***********************************************/
+
+	/* Node of a compact_tree. The links are 32-bit indices into the arena of the tree instead of pointers, index 0
+	being the nil sentinel. The value lives in raw storage that is only constructed while the node is in use,
+	so free slots and the sentinel cost no value_type object.*/
+	template <typename T>
+	class compact_node
+	{
+		public:
+			typedef T					value_type;
+			typedef unsigned int		index_type;
+
+		private:
+			char			storage_[sizeof(value_type)] __attribute__((aligned(__alignof__(value_type))));
+
+		public:
+			index_type		parent;
+			index_type		left;
+			index_type		right;
+			unsigned char	colour;
+			bool			live;
+
+		public:
+			/***********************************************
+				Constructors
+			***********************************************/
+
+			/*Default constructor creates a free black node without a value*/
+			compact_node()
+			:parent(0), left(0), right(0), colour(BLACK), live(false) {}
+
+			/*Copy constructor. Copies the value only if @other holds one*/
+			compact_node(const compact_node& other)
+			:parent(other.parent), left(other.left), right(other.right), colour(other.colour), live(false)
+			{
+				if (other.live)
+					construct(other.value());
+			}
+
+			/***********************************************
+				DESTRUCTORS
+			***********************************************/
+
+			/*Destroys the value if the node holds one*/
+			~compact_node()
+			{
+				if (live)
+					destroy();
+			}
+
+			/***********************************************
+				ASSIGNMENT
+			***********************************************/
+
+			compact_node& operator=(const compact_node& other)
+			{
+				if (this != &other)
+				{
+					if (live)
+						destroy();
+					if (other.live)
+						construct(other.value());
+					parent = other.parent;
+					left = other.left;
+					right = other.right;
+					colour = other.colour;
+				}
+				return *this;
+			}
+
+			/***********************************************
+				VALUE
+			***********************************************/
+
+			value_type& value()
+			{ return *static_cast<value_type*>(static_cast<void*>(storage_)); }
+
+			const value_type& value() const
+			{ return *static_cast<const value_type*>(static_cast<const void*>(storage_)); }
+
+			/*Copy constructs the value of the node from @value*/
+			void construct(const value_type& val)
+			{
+				::new(static_cast<void*>(storage_)) value_type(val);
+				live = true;
+			}
+
+			/*Destroys the value of the node*/
+			void destroy()
+			{
+				value().~value_type();
+				live = false;
+			}
+	};
+
+	/***********************************************
+		COMPACT TREE ITERATOR
+	***********************************************/
+
+	/* Bidirectional iterator over a compact_tree. It holds the tree and an index rather than a node address,
+	so it stays valid when the arena grows. @Value is the value_type of the tree, const qualified for const_iterator.*/
+	template <typename Tree, typename Value>
+	class compact_tree_iterator
+	{
+		public:
+			typedef typename Tree::value_type									value_type;
+			typedef Value*														pointer;
+			typedef Value&														reference;
+			typedef typename Tree::difference_type								difference_type;
+			typedef bidirectional_iterator_tag									iterator_category;
+			typedef typename Tree::index_type									index_type;
+
+		private:
+			typedef compact_tree_iterator<Tree, typename ft::remove_const<Value>::type>	non_const_iterator;
+
+		protected:
+			const Tree*		tree_;
+			index_type		index_;
+
+		public:
+			/***********************************************
+				Constructors
+			***********************************************/
+
+			/*Default Constructor*/
+			compact_tree_iterator()
+			:tree_(mynullptr), index_(0) {}
+
+			/*Constructor initialized with the node at @index of @tree*/
+			compact_tree_iterator(const Tree* tree, index_type index)
+			:tree_(tree), index_(index) {}
+
+			/*Copy Constructor, also converts an iterator to a const_iterator*/
+			compact_tree_iterator(const non_const_iterator& other)
+			:tree_(other.tree()), index_(other.index()) {}
+
+			/***********************************************
+				DESTRUCTORS
+			***********************************************/
+
+			/*default destructor*/
+			~compact_tree_iterator() {}
+
+			/***********************************************
+				ACCESS
+			***********************************************/
+
+			const Tree* tree() const
+			{ return tree_; }
+
+			index_type index() const
+			{ return index_; }
+
+			reference operator*() const
+			{ return const_cast<reference>(tree_->value_(index_)); }
+
+			pointer operator->() const
+			{ return &operator*(); }
+
+			/***********************************************
+				BIDIRECTIONAL ITERATOR REQUIREMENTS
+			***********************************************/
+
+			compact_tree_iterator& operator++()
+			{
+				index_ = tree_->next_(index_);
+				return *this;
+			}
+
+			compact_tree_iterator operator++(int)
+			{
+				compact_tree_iterator tmp = *this;
+				index_ = tree_->next_(index_);
+				return tmp;
+			}
+
+			compact_tree_iterator& operator--()
+			{
+				index_ = tree_->previous_(index_);
+				return *this;
+			}
+
+			compact_tree_iterator operator--(int)
+			{
+				compact_tree_iterator tmp = *this;
+				index_ = tree_->previous_(index_);
+				return tmp;
+			}
+
+			template <typename V>
+			bool operator==(const compact_tree_iterator<Tree, V>& other) const
+			{ return index_ == other.index(); }
+
+			template <typename V>
+			bool operator!=(const compact_tree_iterator<Tree, V>& other) const
+			{ return index_ != other.index(); }
+	};
+
+	/***********************************************
+		COMPACT TREE
+	***********************************************/
+
+	/* ft::compact_tree is a red-black tree whose nodes are kept in one ft::vector and linked through 32-bit indices.
+	For small values a node takes about half the space of an ft::Node plus its heap block, and neighbouring nodes
+	share cache lines. Erased nodes go to a free list and are reused by later insertions.
+	Iterators stay valid until their element is erased, but references and pointers to elements are invalidated
+	whenever an insertion grows the arena, as with ft::vector; reserve() avoids that. Iterators refer to their tree,
+	so unlike those of ft::map they do not follow the elements through swap(). At most 2^32 - 2 elements.*/
+	template <typename T, typename COMPARE, typename Allocator>
+	class compact_tree
+	{
+		public:
+			typedef T															value_type;
+			typedef COMPARE														value_compare;
+			typedef Allocator													allocator_type;
+
+			typedef compact_node<value_type>									node_type;
+			typedef typename node_type::index_type								index_type;
+			typedef typename allocator_type::template rebind<node_type>::other 	node_allocator_type;
+
+			typedef typename allocator_type::size_type							size_type;
+			typedef typename allocator_type::difference_type					difference_type;
+			typedef typename allocator_type::pointer							pointer;
+			typedef typename allocator_type::const_pointer						const_pointer;
+
+			typedef compact_tree_iterator<compact_tree, value_type>				iterator;
+			typedef compact_tree_iterator<compact_tree, const value_type>		const_iterator;
+			typedef ft::reverse_iterator<iterator>								reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>						const_reverse_iterator;
+
+		private:
+			typedef ft::vector<node_type, node_allocator_type>					arena_type;
+
+			template <typename, typename>
+			friend class compact_tree_iterator;
+
+			/*Stateless comparators take no space next to the element count*/
+			ft::compressed_pair<value_compare, index_type>						compare_count_;
+			arena_type															nodes_;
+			index_type															root_;
+			index_type															left_most_;
+			index_type															free_;
+
+			value_compare& compare_() { return compare_count_.first(); }
+
+			const value_compare& compare_() const { return compare_count_.first(); }
+
+			index_type& node_count_() { return compare_count_.second(); }
+
+			const index_type& node_count_() const { return compare_count_.second(); }
+
+			index_type& parent_(index_type i) { return nodes_[i].parent; }
+
+			index_type& left_(index_type i) { return nodes_[i].left; }
+
+			index_type& right_(index_type i) { return nodes_[i].right; }
+
+			const value_type& value_(index_type i) const { return nodes_[i].value(); }
+
+			/*Slot 0 of the arena is the nil sentinel. Its parent is the rightmost node, so end() can be decremented.*/
+			index_type& right_most_() { return nodes_[0].parent; }
+
+			/*Lets the shared red-black code of rbt_balance.hpp follow the index links of the arena, 0 being nil*/
+			class node_access_
+			{
+				public:
+					explicit node_access_(arena_type& nodes): nodes_(&nodes) {}
+
+					index_type& parent(index_type i) const { return (*nodes_)[i].parent; }
+
+					index_type& left(index_type i) const { return (*nodes_)[i].left; }
+
+					index_type& right(index_type i) const { return (*nodes_)[i].right; }
+
+					unsigned char& colour(index_type i) const { return (*nodes_)[i].colour; }
+
+					index_type nil(index_type) const { return 0; }
+
+				private:
+					arena_type*	nodes_;
+			};
+
+			node_access_ access_() { return node_access_(nodes_); }
+
+		public:
+			compact_tree(const value_compare& compare, const allocator_type& alloc)
+			:compare_count_(compare, 0), nodes_(1, node_type(), node_allocator_type(alloc)), root_(0), left_most_(0), free_(0)
+			{ }
+
+			/*Copies the arena as a whole: the copy has the same layout and no node is relinked*/
+			compact_tree(const compact_tree& other)
+			:compare_count_(other.compare_count_), nodes_(other.nodes_), root_(other.root_),
+			left_most_(other.left_most_), free_(other.free_)
+			{ }
+
+			compact_tree& operator=(const compact_tree& other)
+			{
+				if (this != &other)
+				{
+					arena_type nodes(other.nodes_);
+
+					nodes_.swap(nodes);
+					compare_count_ = other.compare_count_;
+					root_ = other.root_;
+					left_most_ = other.left_most_;
+					free_ = other.free_;
+				}
+				return *this;
+			}
+
+			~compact_tree() {}
+
+			/***********************************************
+				Iterators
+			***********************************************/
+
+			iterator begin() { return iterator(this, left_most_); }
+
+			const_iterator begin() const { return const_iterator(this, left_most_); }
+
+			iterator end() { return iterator(this, 0); }
+
+			const_iterator end() const { return const_iterator(this, 0); }
+
+			/***********************************************
+				Capacity
+			***********************************************/
+
+			size_type size() const { return node_count_(); }
+
+			size_type max_size() const
+			{ return ft::min<size_type>(nodes_.max_size(), std::numeric_limits<index_type>::max()) - 1; }
+
+			bool empty() const { return node_count_() == 0; }
+
+			/*Makes room for @n elements, so that the arena does not move before the tree holds that many*/
+			void reserve(size_type n)
+			{
+				if (n > max_size())
+					throw std::length_error("compact_tree::reserve");
+				nodes_.reserve(n + 1);
+			}
+
+			/*Returns the number of elements the arena can hold without growing*/
+			size_type capacity() const { return nodes_.capacity() - 1; }
+
+			/***********************************************
+				GETTERS
+			***********************************************/
+
+			allocator_type get_allocator() const
+			{ return allocator_type(nodes_.get_allocator()); }
+
+			value_compare value_comp() const
+			{ return compare_(); }
+
+		private:
+			/*Returns a node holding a copy of @value, taken from the free list or appended to the arena.
+			Nothing changes if copying @value throws.*/
+			index_type create_new_node_(const value_type& value, COLOUR colour, index_type parent)
+			{
+				if (free_ == 0)
+				{
+					if (nodes_.size() > max_size())
+						throw std::length_error("compact_tree");
+					nodes_.push_back(node_type());
+					free_ = static_cast<index_type>(nodes_.size() - 1);
+				}
+				const index_type index = free_;
+				node_type& node = nodes_[index];
+				node.construct(value);
+				free_ = node.left;
+				node.colour = colour;
+				node.parent = parent;
+				node.left = 0;
+				node.right = 0;
+				return index;
+			}
+
+			/*Destroys the value of @index and puts the slot on the free list*/
+			void destroy_node_(index_type index)
+			{
+				node_type& node = nodes_[index];
+				node.destroy();
+				node.left = free_;
+				free_ = index;
+			}
+
+			index_type leftmost_(index_type i) const
+			{
+				while (nodes_[i].left != 0)
+					i = nodes_[i].left;
+				return i;
+			}
+
+			index_type rightmost_(index_type i) const
+			{
+				while (nodes_[i].right != 0)
+					i = nodes_[i].right;
+				return i;
+			}
+
+			index_type next_(index_type i) const
+			{
+				if (nodes_[i].right != 0)
+					return leftmost_(nodes_[i].right);
+				while (nodes_[i].parent != 0 && i == nodes_[nodes_[i].parent].right)
+					i = nodes_[i].parent;
+				return nodes_[i].parent;
+			}
+
+			index_type previous_(index_type i) const
+			{
+				if (i == 0)
+					return nodes_[0].parent;
+				if (nodes_[i].left != 0)
+					return rightmost_(nodes_[i].left);
+				while (nodes_[i].parent != 0 && i == nodes_[nodes_[i].parent].left)
+					i = nodes_[i].parent;
+				return nodes_[i].parent;
+			}
+
+			/*Returns the first node whose value is not ordered before @key*/
+			template <typename Key>
+			index_type lower_bound_(const Key& key) const
+			{
+				index_type node = root_;
+				index_type result = 0;
+				while (node != 0)
+				{
+					if (compare_()(nodes_[node].value(), key))
+						node = nodes_[node].right;
+					else
+					{
+						result = node;
+						node = nodes_[node].left;
+					}
+				}
+				return result;
+			}
+
+			/*Returns the first node whose value is ordered after @key*/
+			template <typename Key>
+			index_type upper_bound_(const Key& key) const
+			{
+				index_type node = root_;
+				index_type result = 0;
+				while (node != 0)
+				{
+					if (compare_()(key, nodes_[node].value()))
+					{
+						result = node;
+						node = nodes_[node].left;
+					}
+					else
+						node = nodes_[node].right;
+				}
+				return result;
+			}
+
+			template <typename Key>
+			index_type find_(const Key& key) const
+			{
+				index_type node = root_;
+				while (node != 0)
+				{
+					if (compare_()(nodes_[node].value(), key))
+						node = nodes_[node].right;
+					else if (compare_()(key, nodes_[node].value()))
+						node = nodes_[node].left;
+					else
+						return node;
+				}
+				return 0;
+			}
+
+		public:
+			/*Destroys every element. The arena keeps its capacity.*/
+			void clear()
+			{
+				nodes_.resize(1);
+				nodes_[0].parent = 0;
+				node_count_() = 0;
+				root_ = left_most_ = free_ = 0;
+			}
+
+			iterator erase(const_iterator pos)
+			{
+				if (pos == end())
+					return end();
+				index_type z = pos.index();
+				index_type next = next_(z);
+				index_type right_most = z == right_most_() ? previous_(z) : right_most_();
+				index_type y;
+				index_type x;
+				index_type x_parent = parent_(z);
+				const node_access_ access = access_();
+
+				if (left_(z) == 0)
+				{
+					x = right_(z);
+					rbt_transplant(z, x, root_, access);
+				}
+				else if (right_(z) == 0)
+				{
+					x = left_(z);
+					rbt_transplant(z, x, root_, access);
+				}
+				else
+				{
+					y = leftmost_(right_(z));
+					x = right_(y);
+					if (parent_(y) == z)
+						x_parent = y;
+					else
+					{
+						x_parent = parent_(y);
+						rbt_transplant(y, right_(y), root_, access);
+						right_(y) = right_(z);
+						parent_(right_(y)) = y;
+					}
+					rbt_transplant(z, y, root_, access);
+					left_(y) = left_(z);
+					parent_(left_(y)) = y;
+					red_black_balance::swap_state(y, z, access);
+				}
+				if (z == left_most_)
+					left_most_ = next;
+				red_black_balance::erased(z, x, x_parent, root_, tree_counters(), access);
+				destroy_node_(z);
+				right_most_() = right_most;
+				--node_count_();
+				return iterator(this, next);
+			}
+
+			/*Where a lookup ended: the node holding an equivalent value, or 0 with the parent and side a new node
+			for the key would be linked to.*/
+			struct insert_position
+			{
+				index_type		node;
+				index_type		parent;
+				bool			left;
+
+				bool found() const { return node != 0; }
+			};
+
+			/*Descends once for @key and returns the node holding it or the place it belongs*/
+			template <typename Key>
+			insert_position find_position(const Key& key) const
+			{
+				insert_position pos = { root_, 0, false };
+
+				while (pos.node != 0)
+				{
+					pos.parent = pos.node;
+					if (compare_()(key, nodes_[pos.node].value()))
+					{
+						pos.left = true;
+						pos.node = nodes_[pos.node].left;
+					}
+					else if (compare_()(nodes_[pos.node].value(), key))
+					{
+						pos.left = false;
+						pos.node = nodes_[pos.node].right;
+					}
+					else
+						break ;
+				}
+				return pos;
+			}
+
+			/*Links a new node for @value at @pos, which find_position returned for a missing key,
+			and rebalances the tree. No comparisons are made.*/
+			iterator insert_at(const insert_position& pos, const value_type& value)
+			{
+				index_type new_node;
+
+				if (pos.parent == 0)
+				{
+					new_node = create_new_node_(value, BLACK, 0);
+					root_ = left_most_ = right_most_() = new_node;
+				}
+				else
+				{
+					new_node = create_new_node_(value, RED, pos.parent);
+					if (pos.left)
+					{
+						left_(pos.parent) = new_node;
+						if (pos.parent == left_most_)
+							left_most_ = new_node;
+					}
+					else
+					{
+						right_(pos.parent) = new_node;
+						if (pos.parent == right_most_())
+							right_most_() = new_node;
+					}
+				}
+				red_black_balance::inserted(new_node, root_, tree_counters(), access_());
+				++node_count_();
+				return iterator(this, new_node);
+			}
+
+			ft::pair<iterator, bool> insert(const value_type& value)
+			{
+				insert_position pos = find_position(value);
+
+				if (pos.found())
+					return ft::make_pair(iterator(this, pos.node), false);
+				return ft::make_pair(insert_at(pos, value), true);
+			}
+
+			/*Returns the element at @pos, which find_position returned for an existing key*/
+			value_type& value_at(const insert_position& pos)
+			{ return nodes_[pos.node].value(); }
+
+			template <typename Key>
+			iterator find(const Key& key)
+			{ return iterator(this, find_(key)); }
+
+			template <typename Key>
+			const_iterator find(const Key& key) const
+			{ return const_iterator(this, find_(key)); }
+
+			void swap(compact_tree& other)
+			{
+				ft::swap(compare_count_, other.compare_count_);
+				nodes_.swap(other.nodes_);
+				ft::swap(root_, other.root_);
+				ft::swap(left_most_, other.left_most_);
+				ft::swap(free_, other.free_);
+			}
+
+			template <typename Key>
+			iterator lower_bound(const Key& key)
+			{ return iterator(this, lower_bound_(key)); }
+
+			template <typename Key>
+			const_iterator lower_bound(const Key& key) const
+			{ return const_iterator(this, lower_bound_(key)); }
+
+			template <typename Key>
+			iterator upper_bound(const Key& key)
+			{ return iterator(this, upper_bound_(key)); }
+
+			template <typename Key>
+			const_iterator upper_bound(const Key& key) const
+			{ return const_iterator(this, upper_bound_(key)); }
+
+			template <typename Key>
+			ft::pair<iterator,iterator> equal_range(const Key& key)
+			{ return ft::make_pair(lower_bound(key), upper_bound(key)); }
+
+			template <typename Key>
+			ft::pair<const_iterator, const_iterator> equal_range(const Key& key) const
+			{ return ft::make_pair(lower_bound(key), upper_bound(key)); }
+	};
+}
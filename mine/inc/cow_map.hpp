@@ -0,0 +1,428 @@
+#pragma once
+#include "map.hpp"
+#include "utility.hpp"
+#include <new>
+
+namespace ft
+{
+	/* ft::cow_map is an ft::map whose copies share one tree until either side changes it. Copying and assigning
+	are O(1): they only count one more owner. The first modification of a shared map, or the first call that
+	hands out a non-const iterator or reference, clones the tree for that map alone. Meant for maps that are
+	copied to give readers a snapshot, or copied and thrown away unchanged.
+	The owner count is atomic, so copies may be read and changed from different threads; a single cow_map
+	must not be used from several threads at once when one of them changes it, as with ft::map.
+	Iterators and references into a shared tree belong to the tree, not to the map: once the map clones
+	on a later change they keep pointing into the tree the other copies still share. Do not keep them
+	across a copy if you intend to write through them.*/
+	template <typename Key, typename T, typename Compare = std::less<Key>,
+	typename Allocator = std::allocator< ft::pair<const Key, T> >, typename Balance = ft::red_black_balance>
+	class cow_map
+	{
+		public:
+			typedef ft::map<Key, T, Compare, Allocator, Balance>						map_type;
+			typedef typename map_type::key_type											key_type;
+			typedef typename map_type::mapped_type										mapped_type;
+			typedef typename map_type::value_type										value_type;
+			typedef typename map_type::key_compare										key_compare;
+			typedef typename map_type::allocator_type									allocator_type;
+			typedef typename map_type::reference										reference;
+			typedef typename map_type::const_reference									const_reference;
+			typedef typename map_type::pointer											pointer;
+			typedef typename map_type::const_pointer									const_pointer;
+			typedef typename map_type::size_type										size_type;
+			typedef typename map_type::difference_type 									difference_type;
+			typedef typename map_type::iterator											iterator;
+			typedef typename map_type::const_iterator		 							const_iterator;
+			typedef typename map_type::reverse_iterator									reverse_iterator;
+			typedef typename map_type::const_reverse_iterator							const_reverse_iterator;
+			typedef typename map_type::value_compare									value_compare;
+
+		private:
+			/*The tree of all copies and the number of copies that own it*/
+			struct shared_tree_
+			{
+				map_type	map;
+				int			owners;
+
+				explicit shared_tree_(const map_type& m): map(m), owners(1) {}
+
+				shared_tree_(const key_compare& comp, const allocator_type& alloc): map(comp, alloc), owners(1) {}
+			};
+
+			typedef typename allocator_type::template rebind<shared_tree_>::other			shared_allocator_type;
+
+		public:
+			/*Default constructor creates an empty map*/
+			explicit cow_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+			:shared_(create_(comp, alloc)) {}
+
+			template <class InputIterator>
+			cow_map(InputIterator first,
+				InputIterator last,
+				const key_compare& comp = key_compare(),
+				const allocator_type& alloc = allocator_type())
+				:shared_(create_(comp, alloc))
+			{ insert(first, last); }
+
+			/*Copies the contents of @m, which takes O(n). Later copies of the cow_map are O(1).*/
+			explicit cow_map(const map_type& m): shared_(create_(m)) {}
+
+			/*Shares the tree of @other*/
+			cow_map(const cow_map& other): shared_(other.share_()) {}
+
+			~cow_map()
+			{ release_(shared_); }
+
+			/*Lets go of the current tree and shares the one of @other*/
+			cow_map& operator=(const cow_map& other)
+			{
+				if (shared_ != other.shared_)
+				{
+					shared_tree_* shared = other.share_();
+					release_(shared_);
+					shared_ = shared;
+				}
+				return *this;
+			}
+
+		private:
+			shared_tree_* shared_;
+
+			shared_tree_* create_(const key_compare& comp, const allocator_type& alloc)
+			{
+				shared_allocator_type shared_alloc(alloc);
+				shared_tree_* shared = shared_alloc.allocate(1);
+
+				try
+				{
+					new (shared) shared_tree_(comp, alloc);
+				}
+				catch (...)
+				{
+					shared_alloc.deallocate(shared, 1);
+					throw;
+				}
+				return shared;
+			}
+
+			shared_tree_* create_(const map_type& m)
+			{
+				shared_allocator_type shared_alloc(m.get_allocator());
+				shared_tree_* shared = shared_alloc.allocate(1);
+
+				try
+				{
+					new (shared) shared_tree_(m);
+				}
+				catch (...)
+				{
+					shared_alloc.deallocate(shared, 1);
+					throw;
+				}
+				return shared;
+			}
+
+			shared_tree_* share_() const
+			{
+				__sync_fetch_and_add(&shared_->owners, 1);
+				return shared_;
+			}
+
+			/*Drops one owner of @shared and frees the tree when it was the last*/
+			static void release_(shared_tree_* shared)
+			{
+				if (__sync_sub_and_fetch(&shared->owners, 1) != 0)
+					return ;
+				shared_allocator_type shared_alloc(shared->map.get_allocator());
+				shared->~shared_tree_();
+				shared_alloc.deallocate(shared, 1);
+			}
+
+			/*Gives this map a tree of its own if it shares one. Returns whether it had to clone.*/
+			bool detach_()
+			{
+				if (!is_shared())
+					return false;
+				shared_tree_* clone = create_(shared_->map);
+				release_(shared_);
+				shared_ = clone;
+				return true;
+			}
+
+			const map_type& read_() const
+			{ return shared_->map; }
+
+			map_type& write_()
+			{
+				detach_();
+				return shared_->map;
+			}
+
+			/*Detaches and returns the iterator of the own tree that corresponds to @pos of the shared one.
+			The key is copied first: once released, the shared tree may be freed by another owner.*/
+			iterator detach_at_(iterator pos)
+			{
+				if (!is_shared())
+					return pos;
+				if (pos == shared_->map.end())
+				{
+					detach_();
+					return shared_->map.end();
+				}
+				const key_type key(pos->first);
+				detach_();
+				return shared_->map.find(key);
+			}
+
+		public:
+
+			/***********************************************
+				SHARING
+			***********************************************/
+
+			/*Checks if other copies share the tree of this map*/
+			bool is_shared() const
+			{ return __sync_fetch_and_add(&shared_->owners, 0) > 1; }
+
+			/*Returns the number of copies that share the tree of this map, itself included*/
+			size_type use_count() const
+			{ return __sync_fetch_and_add(&shared_->owners, 0); }
+
+			/***********************************************
+				ELEMENT ACCESS
+			***********************************************/
+
+			/*Returns a reference to the mapped value of the element with key equivalent to key.*/
+			mapped_type& at(const key_type& key)
+			{ return write_().at(key); }
+
+			/*Returns a read-only reference to the mapped value of the element with key equivalent to key.*/
+			const mapped_type& at(const key_type& key) const
+			{ return read_().at(key); }
+
+			/*Returns a reference to the value that is mapped to a key equivalent to key,
+			inserting if such key does not already exist.*/
+			mapped_type& operator[](const key_type& key)
+			{ return write_()[key]; }
+
+			/***********************************************
+				ITERATORS
+			***********************************************/
+
+			/*Returns an iterator to the first element of the map.*/
+			iterator begin()
+			{ return write_().begin(); }
+
+			/*Returns an read-only iterator to the first element of the map. */
+			const_iterator begin() const
+			{ return read_().begin(); }
+
+			/*Returns an iterator to the element following the last element of the map.*/
+			iterator end()
+			{ return write_().end(); }
+
+			/*Returns an read-only iterator to the element following the last element of the map. */
+			const_iterator end() const
+			{ return read_().end(); }
+
+			/*Returns a reverse iterator to the first element of the reversed map.*/
+			reverse_iterator rbegin()
+			{ return reverse_iterator(end()); }
+
+			/*Returns a read-only reverse iterator to the first element of the reversed map.*/
+			const_reverse_iterator rbegin() const
+			{ return const_reverse_iterator(end()); }
+
+			/*Returns a reverse iterator to the element following the last element of the reversed map.*/
+			reverse_iterator rend()
+			{ return reverse_iterator(begin()); }
+
+			/*Returns a read-only reverse iterator to the element following the last element of the reversed map. */
+			const_reverse_iterator rend() const
+			{ return const_reverse_iterator(begin()); }
+
+			/***********************************************
+				CAPACITY
+			***********************************************/
+
+			/*Checks if the container has no elements*/
+			bool empty() const
+			{ return read_().empty(); }
+
+			/*Returns the number of elements in the container*/
+			size_type size() const
+			{ return read_().size(); }
+
+			/*Returns the maximum number of elements the container is able to hold*/
+			size_type max_size() const
+			{ return read_().max_size(); }
+
+			/***********************************************
+				MODIFIERS
+			***********************************************/
+
+			/*Erases all elements from the container. A shared tree is left to its other owners, not cloned.*/
+			void clear()
+			{
+				if (!is_shared())
+				{
+					shared_->map.clear();
+					return ;
+				}
+				shared_tree_* empty = create_(read_().key_comp(), get_allocator());
+				release_(shared_);
+				shared_ = empty;
+			}
+
+			/*Inserts element @val into the container, there is no element with equivalent key.*/
+			ft::pair<iterator, bool> insert(const value_type& val)
+			{ return write_().insert(val); }
+
+			/*Inserts elements from range [first, last) */
+			template <class InputIterator>
+			void insert(InputIterator first, InputIterator last)
+			{ write_().insert(first, last); }
+
+			/* Inserts value in the position as close as possible to the position just prior to pos*/
+			iterator insert(iterator pos, const value_type& value)
+			{
+				const iterator hint = detach_at_(pos);
+				return shared_->map.insert(hint, value);
+			}
+
+			/*Inserts a value-initialized element for @key unless the key already exists.*/
+			ft::pair<iterator, bool> try_emplace(const key_type& key)
+			{ return write_().try_emplace(key); }
+
+			/*Inserts an element for @key with the mapped value constructed from @arg unless the key already exists.*/
+			template <class Arg>
+			ft::pair<iterator, bool> try_emplace(const key_type& key, const Arg& arg)
+			{ return write_().try_emplace(key, arg); }
+
+			/*Assigns @obj to the element with key @key, inserting it if the key does not exist yet.*/
+			template <class M>
+			ft::pair<iterator, bool> insert_or_assign(const key_type& key, const M& obj)
+			{ return write_().insert_or_assign(key, obj); }
+
+			/*Removes the element at pos*/
+			iterator erase(iterator pos)
+			{
+				const iterator own = detach_at_(pos);
+				return shared_->map.erase(own);
+			}
+
+			/*Removes the elements in the range [first, last)*/
+			iterator erase(iterator first, iterator last)
+			{
+				if (first == last || !is_shared())
+					return write_().erase(first, last);
+				const key_type first_key(first->first);
+				if (last == shared_->map.end())
+				{
+					detach_();
+					return shared_->map.erase(shared_->map.find(first_key), shared_->map.end());
+				}
+				const key_type last_key(last->first);
+				detach_();
+				return shared_->map.erase(shared_->map.find(first_key), shared_->map.find(last_key));
+			}
+
+			/*Removes the element with the key equivalent to key. A shared tree without the key is not cloned.*/
+			size_type erase(const key_type& key)
+			{
+				if (is_shared() && read_().count(key) == 0)
+					return 0;
+				return write_().erase(key);
+			}
+
+			/*Exchanges the contents of the container with those of other*/
+			void swap(cow_map& other)
+			{ ft::swap(shared_, other.shared_); }
+
+			/***********************************************
+				Lookup
+			***********************************************/
+
+			/*Returns the number of elements with key that compares equivalent to the specified argument.*/
+			size_type count(const key_type& key) const
+			{ return read_().count(key); }
+
+			/*Finds an element with key equivalent to key.*/
+			iterator find(const key_type& key)
+			{ return write_().find(key); }
+
+			/*Finds an element with key equivalent to key.*/
+			const_iterator find(const key_type& key) const
+			{ return read_().find(key); }
+
+			/*Returns a range containing all elements with the given key in the container.*/
+			ft::pair<iterator, iterator> equal_range(const key_type& key)
+			{ return write_().equal_range(key); }
+
+			/*Returns a range containing all elements with the given key in the container.*/
+			ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+			{ return read_().equal_range(key); }
+
+			/*Returns an iterator to the first element whose key is not less than @key.*/
+			iterator lower_bound(const key_type& key)
+			{ return write_().lower_bound(key); }
+
+			const_iterator lower_bound(const key_type& key) const
+			{ return read_().lower_bound(key); }
+
+			/*Returns an iterator to the first element whose key is greater than @key.*/
+			iterator upper_bound(const key_type& key)
+			{ return write_().upper_bound(key); }
+
+			const_iterator upper_bound(const key_type& key) const
+			{ return read_().upper_bound(key); }
+
+			/***********************************************
+				OBSERVERS
+			***********************************************/
+
+			/*Returns the function that compares keys*/
+			key_compare key_comp() const
+			{ return read_().key_comp(); }
+
+			value_compare value_comp() const
+			{ return read_().value_comp(); }
+
+			allocator_type get_allocator() const
+			{ return read_().get_allocator(); }
+	};
+
+	template <typename Key, typename T, typename Compare, typename Allocator, typename Balance>
+	inline bool operator==(const cow_map<Key, T, Compare, Allocator, Balance>& lhs,
+						const cow_map<Key, T, Compare, Allocator, Balance>& rhs)
+	{ return (lhs.size() == rhs.size()) && ft::equal(lhs.begin(), lhs.end(), rhs.begin());}
+
+	template <typename Key, typename T, typename Compare, typename Allocator, typename Balance>
+	inline bool operator!=(const cow_map<Key, T, Compare, Allocator, Balance>& lhs,
+						const cow_map<Key, T, Compare, Allocator, Balance>& rhs)
+	{ return !(lhs == rhs);}
+
+	template <typename Key, typename T, typename Compare, typename Allocator, typename Balance>
+	inline bool operator<(const cow_map<Key, T, Compare, Allocator, Balance>& lhs,
+						const cow_map<Key, T, Compare, Allocator, Balance>& rhs)
+	{ return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());}
+
+	template <typename Key, typename T, typename Compare, typename Allocator, typename Balance>
+	inline bool operator<=(const cow_map<Key, T, Compare, Allocator, Balance>& lhs,
+						const cow_map<Key, T, Compare, Allocator, Balance>& rhs)
+	{ return !(rhs < lhs);}
+
+	template <typename Key, typename T, typename Compare, typename Allocator, typename Balance>
+	inline bool operator>(const cow_map<Key, T, Compare, Allocator, Balance>& lhs,
+						const cow_map<Key, T, Compare, Allocator, Balance>& rhs)
+	{ return rhs < lhs;}
+
+	template <typename Key, typename T, typename Compare, typename Allocator, typename Balance>
+	inline bool operator>=(const cow_map<Key, T, Compare, Allocator, Balance>& lhs,
+						const cow_map<Key, T, Compare, Allocator, Balance>& rhs)
+	{return !(lhs < rhs);}
+
+	template <typename Key, typename T, typename Compare, typename Allocator, typename Balance>
+	inline void swap(cow_map<Key, T, Compare, Allocator, Balance>& x, cow_map<Key, T, Compare, Allocator, Balance>& y)
+	{x.swap(y);}
+}
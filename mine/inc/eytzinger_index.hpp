@@ -0,0 +1,326 @@
+#pragma once
+
+#include "mynullptr.hpp"
+#include "iterator_traits.hpp"
+#include "vector.hpp"
+#include "algorithm.hpp"
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace ft
+{
+	/* Bidirectional iterator visiting the slots of an Eytzinger layout in sorted order.
+	Slot 0 stands for the end, the children of slot k are 2k and 2k + 1.*/
+	template <typename T, typename DIFFTYPE>
+	class eytzinger_iterator
+	{
+		public:
+			typedef T									value_type;
+			typedef const T*							pointer;
+			typedef const T&							reference;
+			typedef DIFFTYPE							difference_type;
+			typedef bidirectional_iterator_tag			iterator_category;
+			typedef std::size_t							size_type;
+
+		protected:
+			pointer		nodes_;
+			size_type	index_;
+			size_type	size_;
+
+		public:
+			/***********************************************
+				Constructors
+			***********************************************/
+
+			/*Default Constructor*/
+			eytzinger_iterator()
+			:nodes_(mynullptr), index_(0), size_(0) {}
+
+			/*Constructor initialized with slot @index of the @size elements at @nodes*/
+			eytzinger_iterator(pointer nodes, size_type index, size_type size)
+			:nodes_(nodes), index_(index), size_(size) {}
+
+			/***********************************************
+				DESTRUCTORS
+			***********************************************/
+
+			/*default destructor*/
+			~eytzinger_iterator() {}
+
+			/***********************************************
+				ACCESS
+			***********************************************/
+
+			reference operator*() const
+			{ return nodes_[index_]; }
+
+			pointer operator->() const
+			{ return nodes_ + index_; }
+
+			/***********************************************
+				BIDIRECTIONAL ITERATOR REQUIREMENTS
+			***********************************************/
+
+			eytzinger_iterator& operator++()
+			{
+				if (2 * index_ + 1 <= size_)
+				{
+					index_ = 2 * index_ + 1;
+					while (2 * index_ <= size_)
+						index_ *= 2;
+				}
+				else
+				{
+					while (index_ & 1)
+						index_ >>= 1;
+					index_ >>= 1;
+				}
+				return *this;
+			}
+
+			eytzinger_iterator operator++(int)
+			{
+				eytzinger_iterator tmp = *this;
+				++*this;
+				return tmp;
+			}
+
+			/*Decrementing the end iterator moves to the last element*/
+			eytzinger_iterator& operator--()
+			{
+				if (index_ == 0)
+				{
+					index_ = 1;
+					while (2 * index_ + 1 <= size_)
+						index_ = 2 * index_ + 1;
+				}
+				else if (2 * index_ <= size_)
+				{
+					index_ = 2 * index_;
+					while (2 * index_ + 1 <= size_)
+						index_ = 2 * index_ + 1;
+				}
+				else
+				{
+					while (index_ != 0 && !(index_ & 1))
+						index_ >>= 1;
+					index_ >>= 1;
+				}
+				return *this;
+			}
+
+			eytzinger_iterator operator--(int)
+			{
+				eytzinger_iterator tmp = *this;
+				--*this;
+				return tmp;
+			}
+
+			bool operator==(const eytzinger_iterator& other) const
+			{ return index_ == other.index_; }
+
+			bool operator!=(const eytzinger_iterator& other) const
+			{ return index_ != other.index_; }
+	};
+
+	/* ft::eytzinger_index is a read-only search structure over a sorted sequence.
+	The elements are stored in breadth-first (Eytzinger) order of the implicit search tree, so the first levels
+	of every search share a few cache lines and the nodes of deeper levels can be prefetched ahead of time.*/
+	template <typename T, typename Compare = std::less<T>, typename Alloc = std::allocator<T> >
+	class eytzinger_index
+	{
+		public:
+			typedef T											value_type;
+			typedef Compare										value_compare;
+			typedef Alloc										allocator_type;
+			typedef typename allocator_type::const_pointer		const_pointer;
+			typedef typename allocator_type::const_reference	const_reference;
+			typedef typename allocator_type::size_type			size_type;
+			typedef typename allocator_type::difference_type	difference_type;
+			typedef eytzinger_iterator<T, difference_type>		const_iterator;
+
+		private:
+			typedef ft::vector<value_type, allocator_type>		storage_type;
+
+			/*Number of tree levels below the current node whose first node is prefetched*/
+			static const size_type prefetch_levels = 4;
+
+		public:
+			/***********************************************
+				Constructors
+			***********************************************/
+
+			/*Default constructor creates an empty index*/
+			explicit eytzinger_index(const value_compare& comp = value_compare(), const allocator_type& alloc = allocator_type())
+			:comp_(comp), nodes_(alloc)
+			{ }
+
+			/*Builds the index from the sorted range [@first, @last)*/
+			template <typename ForwardIterator>
+			eytzinger_index(
+				ForwardIterator first,
+				typename ft::enable_if<!ft::is_integral<ForwardIterator>::value, ForwardIterator>::type last,
+				const value_compare& comp = value_compare(),
+				const allocator_type& alloc = allocator_type())
+			:comp_(comp), nodes_(alloc)
+			{ assign(first, last); }
+
+			/*Builds the index from the sorted vector @sorted*/
+			template <typename VectorAlloc>
+			explicit eytzinger_index(const ft::vector<value_type, VectorAlloc>& sorted, const value_compare& comp = value_compare())
+			:comp_(comp), nodes_()
+			{ assign(sorted.begin(), sorted.end()); }
+
+			/***********************************************
+				DESTRUCTORS
+			***********************************************/
+
+			/*Destructs the index and its copies of the elements*/
+			~eytzinger_index() {}
+
+			/***********************************************
+				ASSIGNMENT
+			***********************************************/
+
+			/*Replaces the contents with the sorted range [@first, @last).
+			Every element is copy constructed once into its slot, so @T need not be assignable.*/
+			template <typename ForwardIterator>
+			void assign(ForwardIterator first, ForwardIterator last)
+			{
+				nodes_.clear();
+				const size_type n = static_cast<size_type>(ft::distance(first, last));
+				if (n == 0)
+					return ;
+				// Slot 0 is unused so that the children of node k are 2k and 2k + 1.
+				ft::vector<ForwardIterator> slots(n + 1, first);
+				build_(first, 1, slots);
+				storage_type nodes;
+				nodes.reserve(n + 1);
+				for (size_type k = 0; k <= n; ++k)
+					nodes.push_back(*slots[k]);
+				nodes_.swap(nodes);
+			}
+
+			/***********************************************
+				CAPACITY
+			***********************************************/
+
+			/*Returns the number of indexed elements*/
+			size_type size() const
+			{ return nodes_.empty() ? 0 : nodes_.size() - 1; }
+
+			/*Checks if the index holds no elements*/
+			bool empty() const
+			{ return size() == 0; }
+
+			/***********************************************
+				ITERATORS
+			***********************************************/
+
+			/*Returns an iterator to the smallest element. The iterators visit the elements in sorted order.*/
+			const_iterator begin() const
+			{
+				size_type k = empty() ? 0 : 1;
+				while (k != 0 && 2 * k <= size())
+					k *= 2;
+				return const_iterator(nodes_.data(), k, size());
+			}
+
+			/*Returns an iterator past the largest element*/
+			const_iterator end() const
+			{ return const_iterator(nodes_.data(), 0, size()); }
+
+			/*Returns the iterator to the element at @p, which a lookup returned, or end() for null*/
+			const_iterator iterator_to(const_pointer p) const
+			{ return const_iterator(nodes_.data(), p == mynullptr ? 0 : p - nodes_.data(), size()); }
+
+			/***********************************************
+				LOOKUP
+			***********************************************/
+
+			/*Returns a pointer to the first element that is not less than @key, or null if there is none.*/
+			template <typename Key>
+			const_pointer lower_bound(const Key& key) const
+			{
+				const size_type n = size();
+				const_pointer nodes = nodes_.data();
+				size_type k = 1;
+				while (k <= n)
+				{
+					ft::prefetch_(nodes + ft::min(k << prefetch_levels, n));
+					k = 2 * k + static_cast<size_type>(comp_(nodes[k], key));
+				}
+				k = ascend_(k);
+				return k == 0 ? mynullptr : nodes + k;
+			}
+
+			/*Returns a pointer to the first element that is greater than @key, or null if there is none.*/
+			template <typename Key>
+			const_pointer upper_bound(const Key& key) const
+			{
+				const size_type n = size();
+				const_pointer nodes = nodes_.data();
+				size_type k = 1;
+				while (k <= n)
+				{
+					ft::prefetch_(nodes + ft::min(k << prefetch_levels, n));
+					k = 2 * k + static_cast<size_type>(!comp_(key, nodes[k]));
+				}
+				k = ascend_(k);
+				return k == 0 ? mynullptr : nodes + k;
+			}
+
+			/*Returns a pointer to the element equivalent to @key, or null if there is none.*/
+			template <typename Key>
+			const_pointer find(const Key& key) const
+			{
+				const_pointer found = lower_bound(key);
+				if (found == mynullptr || comp_(key, *found))
+					return mynullptr;
+				return found;
+			}
+
+			/*Checks if an element equivalent to @key is indexed*/
+			template <typename Key>
+			bool contains(const Key& key) const
+			{ return find(key) != mynullptr; }
+
+			/***********************************************
+				OBSERVERS
+			***********************************************/
+
+			/*Returns the function that orders the elements*/
+			value_compare value_comp() const
+			{ return comp_; }
+
+		private:
+			/*Assigns the elements from @it in order to the slots of the subtree rooted at @k
+			and returns the iterator past the consumed elements*/
+			template <typename ForwardIterator>
+			ForwardIterator build_(ForwardIterator it, size_type k, ft::vector<ForwardIterator>& slots)
+			{
+				if (k < slots.size())
+				{
+					it = build_(it, 2 * k, slots);
+					slots[k] = it;
+					++it;
+					it = build_(it, 2 * k + 1, slots);
+				}
+				return it;
+			}
+
+			/*Undoes the right turns taken after the last left turn of a search that left the tree at @k.
+			The result is the node where the search last went left, 0 if it never did.*/
+			static size_type ascend_(size_type k)
+			{
+				while (k & 1)
+					k >>= 1;
+				return k >> 1;
+			}
+
+		private:
+			value_compare	comp_;
+			storage_type	nodes_;
+	};
+}
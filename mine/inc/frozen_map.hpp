@@ -0,0 +1,136 @@
+#pragma once
+#include "eytzinger_index.hpp"
+#include "iterator.hpp"
+#include "map.hpp"
+#include "utility.hpp"
+#include <stdexcept>
+
+namespace ft
+{
+	/* ft::frozen_map is an immutable snapshot of an ft::map for maps that are built once and then only read.
+	The elements are copied into a single allocation in Eytzinger order (see eytzinger_index), so lookups touch
+	fewer cache lines than a descent through the heap nodes of a red_black_tree and can prefetch ahead.
+	Iteration is in key order like that of the map it was made from.*/
+	template <typename Key, typename T, typename Compare = std::less<Key>,
+	typename Allocator = std::allocator< ft::pair<const Key, T> > >
+	class frozen_map
+	{
+		public:
+			typedef Key																	key_type;
+			typedef T																	mapped_type;
+			typedef ft::pair<const key_type, mapped_type>								value_type;
+			typedef Compare																key_compare;
+			typedef Allocator															allocator_type;
+			typedef typename allocator_type::const_reference							const_reference;
+			typedef typename allocator_type::const_pointer								const_pointer;
+			typedef typename allocator_type::size_type									size_type;
+			typedef typename allocator_type::difference_type 							difference_type;
+
+		private:
+			typedef map_value_type_compare<key_type, value_type, key_compare>			value_type_compare;
+			typedef ft::eytzinger_index<value_type, value_type_compare, allocator_type>	index_type;
+
+		public:
+			typedef typename index_type::const_iterator									iterator;
+			typedef typename index_type::const_iterator									const_iterator;
+			typedef ft::reverse_iterator<const_iterator>								reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>								const_reverse_iterator;
+
+			/*Default constructor creates an empty map*/
+			explicit frozen_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+			:index_(value_type_compare(comp), alloc) {}
+
+			/*Copies the contents of @m, whatever its balancing policy. Later changes to @m are not reflected.*/
+			template <typename Balance>
+			explicit frozen_map(const ft::map<key_type, mapped_type, key_compare, allocator_type, Balance>& m)
+			:index_(m.begin(), m.end(), value_type_compare(m.key_comp()), m.get_allocator()) {}
+
+			~frozen_map() {}
+
+		private:
+			index_type index_;
+
+		public:
+
+			/***********************************************
+				ELEMENT ACCESS
+			***********************************************/
+
+			/*Returns a read-only reference to the mapped value of the element with key equivalent to key.*/
+			const mapped_type& at(const key_type& key) const
+			{
+				const_pointer found = index_.find(key);
+				if (found == mynullptr)
+					throw std::out_of_range("key not found");
+				return found->second;
+			}
+
+			/***********************************************
+				ITERATORS
+			***********************************************/
+
+			/*Returns an iterator to the element with the smallest key.*/
+			const_iterator begin() const
+			{ return index_.begin(); }
+
+			/*Returns an iterator to the element following the last element of the map.*/
+			const_iterator end() const
+			{ return index_.end(); }
+
+			/*Returns a reverse iterator to the first element of the reversed map.*/
+			const_reverse_iterator rbegin() const
+			{ return const_reverse_iterator(end()); }
+
+			/*Returns a reverse iterator to the element following the last element of the reversed map.*/
+			const_reverse_iterator rend() const
+			{ return const_reverse_iterator(begin()); }
+
+			/***********************************************
+				CAPACITY
+			***********************************************/
+
+			/*Checks if the container has no elements*/
+			bool empty() const
+			{ return index_.empty(); }
+
+			/*Returns the number of elements in the container*/
+			size_type size() const
+			{ return index_.size(); }
+
+			/***********************************************
+				Lookup
+			***********************************************/
+
+			/*Returns the number of elements with key that compares equivalent to the specified argument.*/
+			size_type count(const key_type& key) const
+			{ return index_.contains(key) ? 1 : 0; }
+
+			/*Checks if there is an element with key equivalent to key.*/
+			bool contains(const key_type& key) const
+			{ return index_.contains(key); }
+
+			/*Finds an element with key equivalent to key.*/
+			const_iterator find(const key_type& key) const
+			{ return index_.iterator_to(index_.find(key)); }
+
+			/*Returns a range containing all elements with the given key in the container.*/
+			ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+			{ return ft::make_pair(lower_bound(key), upper_bound(key)); }
+
+			/*Returns an iterator to the first element whose key is not less than @key.*/
+			const_iterator lower_bound(const key_type& key) const
+			{ return index_.iterator_to(index_.lower_bound(key)); }
+
+			/*Returns an iterator to the first element whose key is greater than @key.*/
+			const_iterator upper_bound(const key_type& key) const
+			{ return index_.iterator_to(index_.upper_bound(key)); }
+
+			/***********************************************
+				OBSERVERS
+			***********************************************/
+
+			/*Returns the function that compares keys*/
+			key_compare key_comp() const
+			{ return index_.value_comp().key_comp(); }
+	};
+}
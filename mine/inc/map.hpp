@@ -6,35 +6,45 @@
 namespace ft
 {
 	template <typename Key, typename T, typename Compare>
-	class map_value_type_compare : public std::binary_function<Key, Key, bool>
+	class map_value_type_compare : private ft::compressed_slot_<Compare, 0>
 	{
+		private:
+			/*An empty Compare is held as a base class and takes no space*/
+			typedef ft::compressed_slot_<Compare, 0>	comp_base_;
+
 		public:
 			typedef Key  first_argument_type;
 			typedef Key  second_argument_type;
 			typedef bool result_type;
 
 		public:
-			map_value_type_compare() : comp_() {}
+			map_value_type_compare() : comp_base_() {}
 
-			map_value_type_compare(const Compare& c) : comp_(c) {}
+			map_value_type_compare(const Compare& c) : comp_base_(c) {}
 
 		public:
-			const Compare& key_comp() const { return comp_; }
+			const Compare& key_comp() const { return comp_base_::get(); }
 
-			bool operator()(const T& x, const T& y) const { return comp_(x.first, y.first); }
+			bool operator()(const T& x, const T& y) const { return key_comp()(x.first, y.first); }
 
-			bool operator()(const Key& x, const T& y) const { return comp_(x, y.first); }
+			bool operator()(const Key& x, const T& y) const { return key_comp()(x, y.first); }
 
-			bool operator()(const T& x, const Key& y) const { return comp_(x.first, y); }
+			bool operator()(const T& x, const Key& y) const { return key_comp()(x.first, y); }
 
-			void swap(map_value_type_compare& other) { std::swap(comp_, other.comp_); }
+			/*Heterogeneous lookup keys are handed to @Compare unconverted*/
+			template <typename K>
+			bool operator()(const K& x, const T& y) const { return key_comp()(x, y.first); }
 
-		protected:
-			Compare comp_;
+			template <typename K>
+			bool operator()(const T& x, const K& y) const { return key_comp()(x.first, y); }
+
+			void swap(map_value_type_compare& other) { std::swap(comp_base_::get(), other.comp_base_::get()); }
 	};
 
+	/* @Balance selects the balancing policy of the underlying tree: red_black_balance, avl_balance or
+	splay_balance (see rbt_balance.hpp). The interface is the same for all three.*/
 	template <typename Key, typename T, typename Compare = std::less<Key>, 
-	typename Allocator = std::allocator< ft::pair<const Key, T> > >
+	typename Allocator = std::allocator< ft::pair<const Key, T> >, typename Balance = ft::red_black_balance>
 	class map
 	{
 		public:
@@ -52,7 +62,7 @@ namespace ft
 
 		private:
 			typedef map_value_type_compare<key_type, value_type, key_compare>			value_type_compare;
-			typedef ft::red_black_tree<value_type, value_type_compare, allocator_type>	tree_type;
+			typedef ft::red_black_tree<value_type, value_type_compare, allocator_type, Balance>	tree_type;
 
 		public:
 			typedef typename tree_type::iterator										iterator;
@@ -111,6 +121,13 @@ namespace ft
 			tree_type tree_;
 
 		public:
+			/*Last-access cache for lookups in a map, see ft::tree_finger. Each find starts where the previous one
+			ended, which pays off for streams of neighbouring keys. Counts hits and misses.*/
+			class finger : public ft::tree_finger<tree_type, iterator>
+			{
+				public:
+					explicit finger(map& owner) : ft::tree_finger<tree_type, iterator>(owner.tree_) {}
+			};
 
 			/***********************************************
 				ELEMENT ACCESS
@@ -137,9 +154,7 @@ namespace ft
 			/*Returns a reference to the value that is mapped to a key equivalent to key, 
 			inserting if such key does not already exist.*/
 			mapped_type& operator[](const Key& key)
-			{
-				return tree_.insert(ft::make_pair(key, mapped_type())).first->second;
-			}
+			{ return try_emplace(key).first->second; }
 
 			/***********************************************
 				ITERATORS
@@ -223,6 +238,57 @@ namespace ft
 				return tree_.insert(value).first;
 			}
 
+			/*Inserts a value-initialized element for @key unless the key already exists.
+			The map is searched once and no value is constructed if the key is found.*/
+			ft::pair<iterator, bool> try_emplace(const key_type& key)
+			{
+				typename tree_type::insert_position pos = tree_.find_position(key);
+
+				if (pos.node != pos.node->nil)
+					return ft::make_pair(iterator(pos.node), false);
+				return ft::make_pair(tree_.insert_at(pos, value_type(key, mapped_type())), true);
+			}
+
+			/*Inserts an element for @key with the mapped value constructed from @arg unless the key already exists.
+			The map is searched once and @arg is left unused if the key is found.*/
+			template <class Arg>
+			ft::pair<iterator, bool> try_emplace(const key_type& key, const Arg& arg)
+			{
+				typename tree_type::insert_position pos = tree_.find_position(key);
+
+				if (pos.node != pos.node->nil)
+					return ft::make_pair(iterator(pos.node), false);
+				return ft::make_pair(tree_.insert_at(pos, value_type(key, mapped_type(arg))), true);
+			}
+
+			/*Assigns @obj to the element with key @key, inserting it if the key does not exist yet.
+			Returns the element and whether it was inserted. The map is searched once.*/
+			template <class M>
+			ft::pair<iterator, bool> insert_or_assign(const key_type& key, const M& obj)
+			{
+				typename tree_type::insert_position pos = tree_.find_position(key);
+
+				if (pos.node != pos.node->nil)
+				{
+					pos.node->value.second = obj;
+					return ft::make_pair(iterator(pos.node), false);
+				}
+				return ft::make_pair(tree_.insert_at(pos, value_type(key, obj)), true);
+			}
+
+			/*Calls @f with the mapped value of @key, after inserting @default_value for it if the key was missing.
+			Counting, for example, becomes update(key, add_one, 0). The map is searched once.*/
+			template <class Function>
+			iterator update(const key_type& key, Function f, const mapped_type& default_value)
+			{
+				typename tree_type::insert_position pos = tree_.find_position(key);
+				iterator it = pos.node != pos.node->nil ? iterator(pos.node)
+					: tree_.insert_at(pos, value_type(key, default_value));
+
+				f(it->second);
+				return it;
+			}
+
 			/*Removes the element at pos*/
 			iterator erase(iterator pos)
 			{
@@ -287,6 +353,17 @@ namespace ft
 			const_iterator find(const key_type& key) const
 			{ return tree_.find(key); }
 
+			/*Writes find(key) for every key in [first, last) to @out. Interleaves the descents of several keys
+			to overlap their cache misses, which is faster than a loop over find for large maps.*/
+			template <class ForwardIterator, class OutputIterator>
+			OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out)
+			{ return tree_.find_batch(first, last, out); }
+
+			/*Writes find(key) for every key in [first, last) to @out as read-only iterators.*/
+			template <class ForwardIterator, class OutputIterator>
+			OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out) const
+			{ return tree_.find_batch(first, last, out); }
+
 			/*Returns a range containing all elements with the given key in the container.*/
 			ft::pair<iterator,iterator> equal_range(const key_type& key )
 			{ return tree_.equal_range(key); }
@@ -308,6 +385,70 @@ namespace ft
 			const_iterator upper_bound(const key_type& key) const 
 			{ return tree_.upper_bound(key); }
 
+			/***********************************************
+				HETEROGENEOUS LOOKUP
+			***********************************************/
+
+			/*The overloads below take any key type @K that key_compare can order against key_type. They only exist
+			if key_compare defines is_transparent, and avoid constructing a temporary key_type per lookup.*/
+
+			/*Returns the number of elements with key equivalent to @key.*/
+			template <typename K>
+			typename ft::enable_if_transparent<key_compare, K, size_type>::type count(const K& key) const
+			{ return tree_.find(key) == end() ? 0 : 1; }
+
+			/*Finds an element with key equivalent to @key.*/
+			template <typename K>
+			typename ft::enable_if_transparent<key_compare, K, iterator>::type find(const K& key)
+			{ return tree_.find(key); }
+
+			/*Finds an element with key equivalent to @key.*/
+			template <typename K>
+			typename ft::enable_if_transparent<key_compare, K, const_iterator>::type find(const K& key) const
+			{ return tree_.find(key); }
+
+			/*Returns a range containing all elements with key equivalent to @key.*/
+			template <typename K>
+			typename ft::enable_if_transparent<key_compare, K, ft::pair<iterator, iterator> >::type
+			equal_range(const K& key)
+			{ return tree_.equal_range(key); }
+
+			/*Returns a range containing all elements with key equivalent to @key.*/
+			template <typename K>
+			typename ft::enable_if_transparent<key_compare, K, ft::pair<const_iterator, const_iterator> >::type
+			equal_range(const K& key) const
+			{ return tree_.equal_range(key); }
+
+			/*Returns an iterator to the first element whose key is not less than @key.*/
+			template <typename K>
+			typename ft::enable_if_transparent<key_compare, K, iterator>::type lower_bound(const K& key)
+			{ return tree_.lower_bound(key); }
+
+			template <typename K>
+			typename ft::enable_if_transparent<key_compare, K, const_iterator>::type lower_bound(const K& key) const
+			{ return tree_.lower_bound(key); }
+
+			/*Returns an iterator to the first element whose key is greater than @key.*/
+			template <typename K>
+			typename ft::enable_if_transparent<key_compare, K, iterator>::type upper_bound(const K& key)
+			{ return tree_.upper_bound(key); }
+
+			template <typename K>
+			typename ft::enable_if_transparent<key_compare, K, const_iterator>::type upper_bound(const K& key) const
+			{ return tree_.upper_bound(key); }
+
+			/*Removes the element with key equivalent to @key.*/
+			template <typename K>
+			typename ft::enable_if_transparent<key_compare, K, size_type>::type erase(const K& key)
+			{
+				iterator node = tree_.find(key);
+
+				if (node == end())
+					return 0;
+				tree_.erase(node);
+				return 1;
+			}
+
 			/***********************************************
 				OBSERVERS
 			***********************************************/
@@ -322,42 +463,53 @@ namespace ft
 			allocator_type get_allocator() const
 			{ return tree_.get_allocator(); }
 
+			/*Returns the comparisons, rotations and rebalancing steps counted since the map was made or
+			reset_stats() was last called, and its current height and black height. The counters are
+			only collected if FT_TREE_STATS is defined; without it they are zero and cost nothing.
+			A stats build is single-threaded only: its lookups update the counters, even on a const map.*/
+			ft::tree_stats stats() const
+			{ return tree_.stats(); }
+
+			/*Sets the counters reported by stats() back to zero*/
+			void reset_stats()
+			{ tree_.reset_stats(); }
+
 			void print_tree()
 			{ tree_.print_from_node_(tree_.root_node());};
 
 	};
 
-	template <typename Key, typename T, typename Compare, typename Allocator>
-	inline bool operator==(const map<Key, T, Compare, Allocator>& lhs,
-						const map<Key, T, Compare, Allocator>& rhs)
+	template <typename Key, typename T, typename Compare, typename Allocator, typename Balance>
+	inline bool operator==(const map<Key, T, Compare, Allocator, Balance>& lhs,
+						const map<Key, T, Compare, Allocator, Balance>& rhs)
 	{ return (lhs.size() == rhs.size()) && ft::equal(lhs.begin(), lhs.end(), rhs.begin());}
 
-	template <typename Key, typename T, typename Compare, typename Allocator>
-	inline bool operator!=(const map<Key, T, Compare, Allocator>& lhs,
-						const map<Key, T, Compare, Allocator>& rhs)
+	template <typename Key, typename T, typename Compare, typename Allocator, typename Balance>
+	inline bool operator!=(const map<Key, T, Compare, Allocator, Balance>& lhs,
+						const map<Key, T, Compare, Allocator, Balance>& rhs)
 	{ return !(lhs == rhs);}
 
-	template <typename Key, typename T, typename Compare, typename Allocator>
-	inline bool operator<(const map<Key, T, Compare, Allocator>& lhs,
-						const map<Key, T, Compare, Allocator>& rhs)
+	template <typename Key, typename T, typename Compare, typename Allocator, typename Balance>
+	inline bool operator<(const map<Key, T, Compare, Allocator, Balance>& lhs,
+						const map<Key, T, Compare, Allocator, Balance>& rhs)
 	{ return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());}
 
-	template <typename Key, typename T, typename Compare, typename Allocator>
-	inline bool operator<=(const map<Key, T, Compare, Allocator>& lhs,
-						const map<Key, T, Compare, Allocator>& rhs)
+	template <typename Key, typename T, typename Compare, typename Allocator, typename Balance>
+	inline bool operator<=(const map<Key, T, Compare, Allocator, Balance>& lhs,
+						const map<Key, T, Compare, Allocator, Balance>& rhs)
 	{ return !(rhs < lhs);}
 
-	template <typename Key, typename T, typename Compare, typename Allocator>
-	inline bool operator>(const map<Key, T, Compare, Allocator>& lhs,
-						const map<Key, T, Compare, Allocator>& rhs)
+	template <typename Key, typename T, typename Compare, typename Allocator, typename Balance>
+	inline bool operator>(const map<Key, T, Compare, Allocator, Balance>& lhs,
+						const map<Key, T, Compare, Allocator, Balance>& rhs)
 	{ return rhs < lhs;}
 
-	template <typename Key, typename T, typename Compare, typename Allocator>
-	inline bool operator>=(const map<Key, T, Compare, Allocator>& lhs,
-						const map<Key, T, Compare, Allocator>& rhs)
+	template <typename Key, typename T, typename Compare, typename Allocator, typename Balance>
+	inline bool operator>=(const map<Key, T, Compare, Allocator, Balance>& lhs,
+						const map<Key, T, Compare, Allocator, Balance>& rhs)
 	{return !(lhs < rhs);}
 
-	template <typename Key, typename T, typename Compare, typename Allocator>
-	inline void swap(map<Key, T, Compare, Allocator>& x, map<Key, T, Compare, Allocator>& y)
+	template <typename Key, typename T, typename Compare, typename Allocator, typename Balance>
+	inline void swap(map<Key, T, Compare, Allocator, Balance>& x, map<Key, T, Compare, Allocator, Balance>& y)
 	{x.swap(y);}
 }
\ No newline at end of file
@@ -0,0 +1,637 @@
+#pragma once
+
+#include "algorithm.hpp"
+#include <cstddef>
+#include <limits>
+#include <new>
+
+namespace ft
+{
+	/*Alignment suitable for every scalar type, used when a caller does not ask for a specific one*/
+	union max_align_helper_
+	{
+		long double		ld;
+		double			d;
+		long			l;
+		void*			p;
+		void			(*fp)();
+	};
+
+	static const std::size_t max_align = __alignof__(max_align_helper_);
+
+	/*Rounds @n up to a multiple of @align, which must be a power of two*/
+	inline std::size_t align_up_(std::size_t n, std::size_t align)
+	{ return (n + align - 1) & ~(align - 1); }
+
+	/***********************************************
+		MEMORY RESOURCE
+	***********************************************/
+
+	/* ft::memory_resource is the interface of a source of raw memory. Containers reach it through
+	ft::polymorphic_allocator, so their type does not depend on where their memory comes from.*/
+	class memory_resource
+	{
+		public:
+			virtual ~memory_resource() {}
+
+			/*Allocates @bytes with at least the alignment @align. Throws std::bad_alloc on failure.*/
+			void* allocate(std::size_t bytes, std::size_t align = max_align)
+			{ return do_allocate(bytes, align); }
+
+			/*Returns storage obtained from allocate(@bytes, @align) of this or an equal resource*/
+			void deallocate(void* p, std::size_t bytes, std::size_t align = max_align)
+			{ do_deallocate(p, bytes, align); }
+
+			/*Checks if memory allocated from @other can be deallocated through this resource and vice versa*/
+			bool is_equal(const memory_resource& other) const
+			{ return do_is_equal(other); }
+
+		protected:
+			virtual void* do_allocate(std::size_t bytes, std::size_t align) = 0;
+
+			virtual void do_deallocate(void* p, std::size_t bytes, std::size_t align) = 0;
+
+			virtual bool do_is_equal(const memory_resource& other) const = 0;
+	};
+
+	inline bool operator==(const memory_resource& lhs, const memory_resource& rhs)
+	{ return &lhs == &rhs || lhs.is_equal(rhs); }
+
+	inline bool operator!=(const memory_resource& lhs, const memory_resource& rhs)
+	{ return !(lhs == rhs); }
+
+	/*Resource forwarding to the global operator new and operator delete. Alignments above max_align are
+	met by over-allocating and keeping the original address in front of the returned block.*/
+	class new_delete_resource_ : public memory_resource
+	{
+		protected:
+			virtual void* do_allocate(std::size_t bytes, std::size_t align)
+			{
+				if (align <= max_align)
+					return ::operator new(bytes);
+				char* raw = static_cast<char*>(::operator new(bytes + align + sizeof(void*)));
+				char* block = raw + (align_up_(reinterpret_cast<std::size_t>(raw) + sizeof(void*), align)
+					- reinterpret_cast<std::size_t>(raw));
+				reinterpret_cast<void**>(block)[-1] = raw;
+				return block;
+			}
+
+			virtual void do_deallocate(void* p, std::size_t, std::size_t align)
+			{
+				if (align <= max_align)
+					::operator delete(p);
+				else
+					::operator delete(static_cast<void**>(p)[-1]);
+			}
+
+			virtual bool do_is_equal(const memory_resource& other) const
+			{ return this == &other; }
+	};
+
+	/*Resource that throws std::bad_alloc on every allocation*/
+	class null_resource_ : public memory_resource
+	{
+		protected:
+			virtual void* do_allocate(std::size_t, std::size_t)
+			{ throw std::bad_alloc(); }
+
+			virtual void do_deallocate(void*, std::size_t, std::size_t) {}
+
+			virtual bool do_is_equal(const memory_resource& other) const
+			{ return this == &other; }
+	};
+
+	/*Returns the process wide resource that uses the global operator new and operator delete*/
+	inline memory_resource* new_delete_resource()
+	{
+		static new_delete_resource_ resource;
+		return &resource;
+	}
+
+	/*Returns the process wide resource that fails every allocation. Serves as upstream of a
+	monotonic_buffer_resource that must never outgrow its initial buffer.*/
+	inline memory_resource* null_memory_resource()
+	{
+		static null_resource_ resource;
+		return &resource;
+	}
+
+	inline memory_resource*& default_resource_slot_()
+	{
+		static memory_resource* resource = new_delete_resource();
+		return resource;
+	}
+
+	/*Returns the resource used by default constructed polymorphic_allocators*/
+	inline memory_resource* get_default_resource()
+	{ return default_resource_slot_(); }
+
+	/*Replaces the default resource with @r, or with new_delete_resource() if @r is null, and returns the previous one*/
+	inline memory_resource* set_default_resource(memory_resource* r)
+	{
+		memory_resource* previous = default_resource_slot_();
+		default_resource_slot_() = r != 0 ? r : new_delete_resource();
+		return previous;
+	}
+
+	/***********************************************
+		MONOTONIC BUFFER RESOURCE
+	***********************************************/
+
+	/* ft::monotonic_buffer_resource hands out memory by bumping a pointer through chunks obtained from its upstream
+	resource. Deallocation does nothing; all memory is returned at once by release() or the destructor.
+	Meant for objects that die together, like the containers of one request. Not thread safe.*/
+	class monotonic_buffer_resource : public memory_resource
+	{
+		private:
+			/*Header at the start of every chunk taken from upstream*/
+			struct chunk_
+			{
+				chunk_*			next;
+				std::size_t		size;
+			};
+
+			/*Size of the first chunk if none is given. Enumerators need no out-of-class definition.*/
+			enum { default_initial_size = 1024 };
+
+		public:
+			/***********************************************
+				Constructors
+			***********************************************/
+
+			/*Constructor drawing chunks from @upstream*/
+			explicit monotonic_buffer_resource(memory_resource* upstream = get_default_resource())
+			:upstream_(upstream), chunks_(0), initial_buffer_(0), initial_size_(0),
+			current_(0), left_(0), next_size_(default_initial_size)
+			{ }
+
+			/*Constructor whose first chunk from @upstream has room for @initial_size bytes*/
+			explicit monotonic_buffer_resource(std::size_t initial_size, memory_resource* upstream = get_default_resource())
+			:upstream_(upstream), chunks_(0), initial_buffer_(0), initial_size_(0),
+			current_(0), left_(0), next_size_(ft::max<std::size_t>(initial_size, 1))
+			{ }
+
+			/*Constructor serving allocations from @buffer of @size bytes first, then from @upstream.
+			The buffer is not owned and must outlive the resource.*/
+			monotonic_buffer_resource(void* buffer, std::size_t size, memory_resource* upstream = get_default_resource())
+			:upstream_(upstream), chunks_(0), initial_buffer_(static_cast<char*>(buffer)), initial_size_(size),
+			current_(static_cast<char*>(buffer)), left_(size), next_size_(ft::max<std::size_t>(size * 2, default_initial_size))
+			{ }
+
+			/***********************************************
+				DESTRUCTORS
+			***********************************************/
+
+			/*Returns all chunks to the upstream resource*/
+			virtual ~monotonic_buffer_resource()
+			{ release(); }
+
+			/***********************************************
+				MODIFIERS
+			***********************************************/
+
+			/*Returns all chunks to the upstream resource and restarts at the initial buffer.
+			Costs one upstream deallocation per chunk, independent of the number of allocations.*/
+			void release()
+			{
+				while (chunks_ != 0)
+				{
+					chunk_* next = chunks_->next;
+					upstream_->deallocate(chunks_, chunks_->size, max_align);
+					chunks_ = next;
+				}
+				current_ = initial_buffer_;
+				left_ = initial_size_;
+			}
+
+			/***********************************************
+				OBSERVERS
+			***********************************************/
+
+			/*Returns the resource chunks are taken from*/
+			memory_resource* upstream_resource() const
+			{ return upstream_; }
+
+		protected:
+			virtual void* do_allocate(std::size_t bytes, std::size_t align)
+			{
+				std::size_t padding = align_up_(reinterpret_cast<std::size_t>(current_), align)
+					- reinterpret_cast<std::size_t>(current_);
+				if (current_ == 0 || padding + bytes > left_)
+				{
+					new_chunk_(bytes, align);
+					padding = align_up_(reinterpret_cast<std::size_t>(current_), align)
+						- reinterpret_cast<std::size_t>(current_);
+				}
+				void* p = current_ + padding;
+				current_ += padding + bytes;
+				left_ -= padding + bytes;
+				return p;
+			}
+
+			virtual void do_deallocate(void*, std::size_t, std::size_t) {}
+
+			virtual bool do_is_equal(const memory_resource& other) const
+			{ return this == &other; }
+
+		private:
+			monotonic_buffer_resource(const monotonic_buffer_resource&);
+			monotonic_buffer_resource& operator=(const monotonic_buffer_resource&);
+
+			/*Takes a chunk with room for @bytes at alignment @align from upstream. Chunk sizes grow geometrically
+			so the number of chunks stays logarithmic in the memory used.*/
+			void new_chunk_(std::size_t bytes, std::size_t align)
+			{
+				const std::size_t header = align_up_(sizeof(chunk_), max_align);
+				const std::size_t size = header + ft::max(next_size_, bytes + align);
+				chunk_* chunk = static_cast<chunk_*>(upstream_->allocate(size, max_align));
+				chunk->next = chunks_;
+				chunk->size = size;
+				chunks_ = chunk;
+				current_ = reinterpret_cast<char*>(chunk) + header;
+				left_ = size - header;
+				if (next_size_ <= std::numeric_limits<std::size_t>::max() / 2)
+					next_size_ *= 2;
+			}
+
+		private:
+			memory_resource*	upstream_;
+			chunk_*				chunks_;
+			char*				initial_buffer_;
+			std::size_t			initial_size_;
+			char*				current_;
+			std::size_t			left_;
+			std::size_t			next_size_;
+	};
+
+	/***********************************************
+		POOL RESOURCE
+	***********************************************/
+
+	/*Tuning of a pool resource. Zero selects the default of a field.*/
+	struct pool_options
+	{
+		/*Upper bound on the number of blocks one chunk of a pool is carved into*/
+		std::size_t		max_blocks_per_chunk;
+		/*Largest allocation served from a pool. Larger ones go straight to upstream.*/
+		std::size_t		largest_required_pool_block;
+
+		pool_options(): max_blocks_per_chunk(0), largest_required_pool_block(0) {}
+	};
+
+	/* ft::unsynchronized_pool_resource serves allocations from pools of equally sized blocks, one pool per power of
+	two size class. Freed blocks go back onto the free list of their pool and are reused, which suits node based
+	containers that insert and erase a lot. Allocations above the largest pool come from upstream directly.
+	Everything is returned to upstream by release() or the destructor. Not thread safe.*/
+	class unsynchronized_pool_resource : public memory_resource
+	{
+		private:
+			struct free_block_
+			{
+				free_block_*	next;
+			};
+
+			/*Header in front of every chunk and every oversized allocation taken from upstream*/
+			struct chunk_
+			{
+				chunk_*			prev;
+				chunk_*			next;
+				std::size_t		size;
+				std::size_t		align;
+			};
+
+			struct pool_
+			{
+				free_block_*	free_list;
+				chunk_*			chunks;
+				std::size_t		block_size;
+				std::size_t		next_blocks;
+			};
+
+			enum
+			{
+				min_block_shift = 3,
+				max_pools = 18,
+				default_largest_block = 4096,
+				default_max_blocks = 1024,
+				first_chunk_blocks = 16
+			};
+
+		public:
+			/***********************************************
+				Constructors
+			***********************************************/
+
+			/*Constructor drawing chunks from @upstream*/
+			explicit unsynchronized_pool_resource(memory_resource* upstream = get_default_resource())
+			:upstream_(upstream), large_(0)
+			{ init_(pool_options()); }
+
+			/*Constructor tuned by @options, drawing chunks from @upstream*/
+			explicit unsynchronized_pool_resource(const pool_options& options, memory_resource* upstream = get_default_resource())
+			:upstream_(upstream), large_(0)
+			{ init_(options); }
+
+			/***********************************************
+				DESTRUCTORS
+			***********************************************/
+
+			/*Returns all memory to the upstream resource*/
+			virtual ~unsynchronized_pool_resource()
+			{ release(); }
+
+			/***********************************************
+				MODIFIERS
+			***********************************************/
+
+			/*Returns all chunks and oversized allocations to the upstream resource*/
+			void release()
+			{
+				for (std::size_t i = 0; i < pool_count_; ++i)
+				{
+					free_chunks_(pools_[i].chunks);
+					pools_[i].chunks = 0;
+					pools_[i].free_list = 0;
+					pools_[i].next_blocks = first_chunk_blocks;
+				}
+				free_chunks_(large_);
+				large_ = 0;
+			}
+
+			/***********************************************
+				OBSERVERS
+			***********************************************/
+
+			/*Returns the resource chunks are taken from*/
+			memory_resource* upstream_resource() const
+			{ return upstream_; }
+
+			/*Returns the effective tuning, with defaults filled in*/
+			pool_options options() const
+			{ return options_; }
+
+		protected:
+			virtual void* do_allocate(std::size_t bytes, std::size_t align)
+			{
+				pool_* pool = pool_for_(bytes, align);
+				if (pool == 0)
+					return allocate_large_(bytes, align);
+				if (pool->free_list == 0)
+					refill_(*pool);
+				free_block_* block = pool->free_list;
+				pool->free_list = block->next;
+				return block;
+			}
+
+			virtual void do_deallocate(void* p, std::size_t bytes, std::size_t align)
+			{
+				pool_* pool = pool_for_(bytes, align);
+				if (pool == 0)
+				{
+					deallocate_large_(p, align);
+					return ;
+				}
+				free_block_* block = static_cast<free_block_*>(p);
+				block->next = pool->free_list;
+				pool->free_list = block;
+			}
+
+			virtual bool do_is_equal(const memory_resource& other) const
+			{ return this == &other; }
+
+		private:
+			unsynchronized_pool_resource(const unsynchronized_pool_resource&);
+			unsynchronized_pool_resource& operator=(const unsynchronized_pool_resource&);
+
+			void init_(const pool_options& options)
+			{
+				options_ = options;
+				if (options_.max_blocks_per_chunk == 0)
+					options_.max_blocks_per_chunk = default_max_blocks;
+				if (options_.largest_required_pool_block == 0)
+					options_.largest_required_pool_block = default_largest_block;
+				pool_count_ = 0;
+				std::size_t size = std::size_t(1) << min_block_shift;
+				do
+				{
+					pools_[pool_count_].free_list = 0;
+					pools_[pool_count_].chunks = 0;
+					pools_[pool_count_].block_size = size;
+					pools_[pool_count_].next_blocks = first_chunk_blocks;
+					++pool_count_;
+					size *= 2;
+				}
+				while (pool_count_ < max_pools && size / 2 < options_.largest_required_pool_block);
+				options_.largest_required_pool_block = size / 2;
+			}
+
+			/*Returns the pool of the smallest size class that fits @bytes at alignment @align, or null if none does.
+			Blocks of a size class are aligned to the size class, up to max_align.*/
+			pool_* pool_for_(std::size_t bytes, std::size_t align)
+			{
+				if (align > max_align)
+					return 0;
+				bytes = ft::max(bytes, align);
+				std::size_t i = 0;
+				while (i < pool_count_ && pools_[i].block_size < bytes)
+					++i;
+				return i < pool_count_ ? &pools_[i] : 0;
+			}
+
+			/*Carves a new chunk from upstream into blocks for @pool. Chunks double in block count up to
+			max_blocks_per_chunk.*/
+			void refill_(pool_& pool)
+			{
+				const std::size_t blocks = pool.next_blocks;
+				char* first = static_cast<char*>(allocate_chunk_(pool.chunks, blocks * pool.block_size, max_align));
+				for (std::size_t i = blocks; i > 0; --i)
+				{
+					free_block_* block = reinterpret_cast<free_block_*>(first + (i - 1) * pool.block_size);
+					block->next = pool.free_list;
+					pool.free_list = block;
+				}
+				pool.next_blocks = ft::min(blocks * 2, ft::max(options_.max_blocks_per_chunk, blocks));
+			}
+
+			void* allocate_large_(std::size_t bytes, std::size_t align)
+			{ return allocate_chunk_(large_, bytes, align); }
+
+			void deallocate_large_(void* p, std::size_t align)
+			{
+				chunk_* chunk = reinterpret_cast<chunk_*>(static_cast<char*>(p) - header_size_(align));
+				if (chunk->prev != 0)
+					chunk->prev->next = chunk->next;
+				else
+					large_ = chunk->next;
+				if (chunk->next != 0)
+					chunk->next->prev = chunk->prev;
+				upstream_->deallocate(chunk, chunk->size, chunk->align);
+			}
+
+			/*Size of the chunk header, padded so that the payload behind it keeps the alignment @align*/
+			static std::size_t header_size_(std::size_t align)
+			{ return align_up_(sizeof(chunk_), ft::max(align, max_align)); }
+
+			/*Takes @bytes plus a header from upstream, links the header into @list and returns the payload*/
+			void* allocate_chunk_(chunk_*& list, std::size_t bytes, std::size_t align)
+			{
+				const std::size_t header = header_size_(align);
+				const std::size_t chunk_align = ft::max(align, max_align);
+				chunk_* chunk = static_cast<chunk_*>(upstream_->allocate(header + bytes, chunk_align));
+				chunk->prev = 0;
+				chunk->next = list;
+				chunk->size = header + bytes;
+				chunk->align = chunk_align;
+				if (list != 0)
+					list->prev = chunk;
+				list = chunk;
+				return reinterpret_cast<char*>(chunk) + header;
+			}
+
+			void free_chunks_(chunk_* chunk)
+			{
+				while (chunk != 0)
+				{
+					chunk_* next = chunk->next;
+					upstream_->deallocate(chunk, chunk->size, chunk->align);
+					chunk = next;
+				}
+			}
+
+		private:
+			memory_resource*	upstream_;
+			pool_options		options_;
+			pool_				pools_[max_pools];
+			std::size_t			pool_count_;
+			chunk_*				large_;
+	};
+
+	/***********************************************
+		POLYMORPHIC ALLOCATOR
+	***********************************************/
+
+	/* ft::polymorphic_allocator is a C++98 allocator that forwards to a memory_resource chosen at run time.
+	Containers rebind it to their node types and copies keep the resource, so a whole map or vector of vectors
+	allocates from the resource it was constructed with. Assigning or swapping containers leaves each with its
+	own resource; swapped containers must use equal resources.*/
+	template <typename T>
+	class polymorphic_allocator
+	{
+		public:
+			typedef T					value_type;
+			typedef T*					pointer;
+			typedef const T*			const_pointer;
+			typedef T&					reference;
+			typedef const T&			const_reference;
+			typedef std::size_t			size_type;
+			typedef std::ptrdiff_t		difference_type;
+
+			template <typename U>
+			struct rebind
+			{ typedef polymorphic_allocator<U> other; };
+
+		public:
+			/***********************************************
+				Constructors
+			***********************************************/
+
+			/*Default constructor. Uses get_default_resource()*/
+			polymorphic_allocator()
+			:resource_(get_default_resource())
+			{ }
+
+			/*Constructor allocating from @resource. Implicit, so a resource can be passed where an allocator is expected.*/
+			polymorphic_allocator(memory_resource* resource)
+			:resource_(resource)
+			{ }
+
+			/*Copy constructor. The copy shares the resource*/
+			polymorphic_allocator(const polymorphic_allocator& other)
+			:resource_(other.resource())
+			{ }
+
+			/*Converting constructor used by rebind*/
+			template <typename U>
+			polymorphic_allocator(const polymorphic_allocator<U>& other)
+			:resource_(other.resource())
+			{ }
+
+			/***********************************************
+				DESTRUCTORS
+			***********************************************/
+
+			/*default destructor*/
+			~polymorphic_allocator() {}
+
+			/***********************************************
+				ADDRESS
+			***********************************************/
+
+			pointer address(reference x) const { return &x; }
+
+			const_pointer address(const_reference x) const { return &x; }
+
+			/***********************************************
+				ALLOCATION
+			***********************************************/
+
+			/*Allocates uninitialized storage for @n objects of type @T from the resource*/
+			pointer allocate(size_type n, const void* = 0)
+			{
+				if (n > max_size())
+					throw std::bad_alloc();
+				return static_cast<pointer>(resource_->allocate(n * sizeof(T), __alignof__(T)));
+			}
+
+			/*Returns the storage for @n objects at @p to the resource*/
+			void deallocate(pointer p, size_type n)
+			{ resource_->deallocate(p, n * sizeof(T), __alignof__(T)); }
+
+			/*Returns the largest number of objects that can be requested from allocate*/
+			size_type max_size() const
+			{ return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+			/***********************************************
+				CONSTRUCTION
+			***********************************************/
+
+			/*Copy constructs an object of type @T at @p*/
+			void construct(pointer p, const_reference value)
+			{ ::new(static_cast<void*>(p)) T(value); }
+
+			/*Calls the destructor of the object at @p*/
+			void destroy(pointer p)
+			{ p->~T(); }
+
+			/***********************************************
+				OBSERVERS
+			***********************************************/
+
+			/*Returns the resource this allocator draws from*/
+			memory_resource* resource() const
+			{ return resource_; }
+
+		private:
+			/*Not assignable: a container keeps the resource it allocated from, see allocator_propagates*/
+			polymorphic_allocator& operator=(const polymorphic_allocator&);
+
+			memory_resource*	resource_;
+	};
+
+	/*Containers keep their polymorphic allocator on copy assignment and swap*/
+	template <typename T>
+	struct allocator_propagates<polymorphic_allocator<T> > : public false_type {};
+
+	/***********************************************
+		NON-MEMBER FUNCTIONS
+	***********************************************/
+
+	/*Polymorphic allocators are interchangeable if their resources are equal*/
+	template <typename T1, typename T2>
+	inline bool operator==(const polymorphic_allocator<T1>& lhs, const polymorphic_allocator<T2>& rhs)
+	{ return *lhs.resource() == *rhs.resource(); }
+
+	template <typename T1, typename T2>
+	inline bool operator!=(const polymorphic_allocator<T1>& lhs, const polymorphic_allocator<T2>& rhs)
+	{ return !(lhs == rhs); }
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+#include "type_traits.hpp"
+#include "algorithm.hpp"
+#include <sys/mman.h>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <new>
+
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+# define MAP_ANONYMOUS MAP_ANON
+#endif
+
+namespace ft
+{
+	/* ft::mmap_allocator hands out large blocks as private anonymous mappings and everything else through
+	operator new. Mapped blocks are advised for transparent huge pages and, on Linux, grown in place with mremap.*/
+	template <typename T>
+	class mmap_allocator
+	{
+		public:
+			typedef T					value_type;
+			typedef T*					pointer;
+			typedef const T*			const_pointer;
+			typedef T&					reference;
+			typedef const T&			const_reference;
+			typedef std::size_t			size_type;
+			typedef std::ptrdiff_t		difference_type;
+
+			template <typename U>
+			struct rebind
+			{ typedef mmap_allocator<U> other; };
+
+			/*Blocks of at least this many bytes are mapped, smaller ones come from operator new*/
+			static const size_type mmap_threshold = 1 << 20;
+
+		public:
+			/***********************************************
+				Constructors
+			***********************************************/
+
+			/*Default constructor. The allocator is stateless*/
+			mmap_allocator() {}
+
+			/*Copy constructor*/
+			mmap_allocator(const mmap_allocator&) {}
+
+			/*Converting constructor used by rebind*/
+			template <typename U>
+			mmap_allocator(const mmap_allocator<U>&) {}
+
+			/***********************************************
+				DESTRUCTORS
+			***********************************************/
+
+			/*default destructor*/
+			~mmap_allocator() {}
+
+			/***********************************************
+				ADDRESS
+			***********************************************/
+
+			pointer address(reference x) const { return &x; }
+
+			const_pointer address(const_reference x) const { return &x; }
+
+			/***********************************************
+				ALLOCATION
+			***********************************************/
+
+			/*Allocates uninitialized storage for @n objects of type @T*/
+			pointer allocate(size_type n, const void* = 0)
+			{
+				if (n > max_size())
+					throw std::bad_alloc();
+				const size_type bytes = n * sizeof(T);
+				if (bytes < mmap_threshold)
+					return static_cast<pointer>(::operator new(bytes));
+				return static_cast<pointer>(map_(bytes));
+			}
+
+			/*Allocates storage for @n objects of type @T with every byte set to zero.
+			Mapped blocks come zero filled from the kernel, so their pages are only touched once written.*/
+			pointer allocate_zeroed(size_type n)
+			{
+				if (n > max_size())
+					throw std::bad_alloc();
+				const size_type bytes = n * sizeof(T);
+				if (bytes >= mmap_threshold)
+					return static_cast<pointer>(map_(bytes));
+				return static_cast<pointer>(std::memset(::operator new(bytes), 0, bytes));
+			}
+
+			/*Deallocates the storage referenced by @p, which must have been obtained by allocate(@n)*/
+			void deallocate(pointer p, size_type n)
+			{
+				const size_type bytes = n * sizeof(T);
+				if (bytes < mmap_threshold)
+					::operator delete(p);
+				else
+					::munmap(p, bytes);
+			}
+
+			/*Moves the @old_n objects at @p into storage for @new_n objects and returns it.
+			Only valid for types that may be relocated bytewise. Mapped blocks are remapped instead of copied.*/
+			pointer reallocate(pointer p, size_type old_n, size_type new_n)
+			{
+				if (new_n > max_size())
+					throw std::bad_alloc();
+				const size_type old_bytes = old_n * sizeof(T);
+				const size_type new_bytes = new_n * sizeof(T);
+#ifdef MREMAP_MAYMOVE
+				if (old_bytes >= mmap_threshold && new_bytes >= mmap_threshold)
+				{
+					void* block = ::mremap(p, old_bytes, new_bytes, MREMAP_MAYMOVE);
+					if (block == MAP_FAILED)
+						throw std::bad_alloc();
+					advise_(block, new_bytes);
+					return static_cast<pointer>(block);
+				}
+#endif
+				pointer block = allocate(new_n);
+				std::memcpy(static_cast<void*>(block), static_cast<const void*>(p), ft::min(old_bytes, new_bytes));
+				deallocate(p, old_n);
+				return block;
+			}
+
+			/*Returns the largest number of objects that can be requested from allocate*/
+			size_type max_size() const
+			{ return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+			/***********************************************
+				CONSTRUCTION
+			***********************************************/
+
+			/*Copy constructs an object of type @T at @p*/
+			void construct(pointer p, const_reference value)
+			{ ::new(static_cast<void*>(p)) T(value); }
+
+			/*Calls the destructor of the object at @p*/
+			void destroy(pointer p)
+			{ p->~T(); }
+
+		private:
+			/*Maps @bytes of zero filled anonymous memory*/
+			static void* map_(size_type bytes)
+			{
+				void* block = ::mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+				if (block == MAP_FAILED)
+					throw std::bad_alloc();
+				advise_(block, bytes);
+				return block;
+			}
+
+			/*Asks the kernel to back the mapping with transparent huge pages where supported*/
+			static void advise_(void* block, size_type bytes)
+			{
+#ifdef MADV_HUGEPAGE
+				::madvise(block, bytes, MADV_HUGEPAGE);
+#else
+				(void) block;
+				(void) bytes;
+#endif
+			}
+	};
+
+	/***********************************************
+		NON-MEMBER FUNCTIONS
+	***********************************************/
+
+	/*mmap_allocators are stateless, any instance can free memory of any other*/
+	template <typename T1, typename T2>
+	inline bool operator==(const mmap_allocator<T1>&, const mmap_allocator<T2>&)
+	{ return true; }
+
+	template <typename T1, typename T2>
+	inline bool operator!=(const mmap_allocator<T1>&, const mmap_allocator<T2>&)
+	{ return false; }
+
+	/*Lets ft::vector grow POD contents through mmap_allocator::reallocate*/
+	template <typename T>
+	struct has_reallocate<mmap_allocator<T> > : public true_type {};
+
+	/*Lets ft::vector skip writing all-zero POD fill values into fresh mappings*/
+	template <typename T>
+	struct has_allocate_zeroed<mmap_allocator<T> > : public true_type {};
+}
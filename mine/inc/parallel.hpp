@@ -0,0 +1,483 @@
+#pragma once
+
+#include "thread_pool.hpp"
+#include "algorithm.hpp"
+#include "vector.hpp"
+#include "map.hpp"
+#include "set.hpp"
+#include <cstddef>
+#include <functional>
+
+namespace ft
+{
+	/***********************************************
+		CHUNKING
+	***********************************************/
+
+	/*One chunk [begin, end) of a parallel loop, queued as a thread_pool task. An exception thrown by the body is
+	reported to the group, which rethrows it from wait() as task_error.*/
+	template <typename Body>
+	struct chunk_task_
+	{
+		Body*			body;
+		std::size_t		begin;
+		std::size_t		end;
+		task_group*		group;
+
+		static void run(void* self)
+		{
+			chunk_task_* chunk = static_cast<chunk_task_*>(self);
+			try
+			{
+				(*chunk->body)(chunk->begin, chunk->end);
+			}
+			catch (const std::exception& e)
+			{
+				chunk->group->fail(e.what());
+			}
+			catch (...)
+			{
+				chunk->group->fail("unknown exception in parallel task");
+			}
+			chunk->group->done();
+		}
+	};
+
+	/*Returns @grain, or for 0 a grain that gives every worker about four chunks but no chunk below 1024 elements*/
+	inline std::size_t resolve_grain_(std::size_t len, std::size_t grain, const thread_pool& pool)
+	{
+		if (grain != 0)
+			return grain;
+		const std::size_t chunks = 4 * pool.size();
+		return ft::max<std::size_t>((len + chunks - 1) / chunks, 1024);
+	}
+
+	/*Runs @body(begin, end) for consecutive chunks of @grain indices covering [0, @len) and waits for all of them.
+	The calling thread takes the first chunk itself and helps with queued tasks while waiting. If a chunk throws,
+	all others still finish; the calling thread's own exception is rethrown as is, one from a task as task_error.*/
+	template <typename Body>
+	void parallel_chunks_(std::size_t len, std::size_t grain, thread_pool& pool, Body& body)
+	{
+		if (len == 0)
+			return ;
+		if (len <= grain)
+		{
+			body(0, len);
+			return ;
+		}
+		const std::size_t count = (len + grain - 1) / grain;
+		ft::vector<chunk_task_<Body> > chunks(count);
+		task_group group(pool);
+		for (std::size_t i = 1; i < count; ++i)
+		{
+			chunks[i].body = &body;
+			chunks[i].begin = i * grain;
+			chunks[i].end = ft::min(len, (i + 1) * grain);
+			chunks[i].group = &group;
+			group.run(&chunk_task_<Body>::run, &chunks[i]);
+		}
+		try
+		{
+			body(0, grain);
+		}
+		catch (...)
+		{
+			group.join();
+			throw;
+		}
+		group.wait();
+	}
+
+	/***********************************************
+		LOOP BODIES
+	***********************************************/
+
+	template <typename RandomIterator, typename Function>
+	struct for_each_body_
+	{
+		RandomIterator	first;
+		Function		function;
+
+		void operator()(std::size_t begin, std::size_t end)
+		{
+			Function f(function);
+			for (RandomIterator it = first + begin; it != first + end; ++it)
+				f(*it);
+		}
+	};
+
+	template <typename RandomIterator, typename OutputIterator, typename UnaryOperation>
+	struct transform_body_
+	{
+		RandomIterator	first;
+		OutputIterator	result;
+		UnaryOperation	operation;
+
+		void operator()(std::size_t begin, std::size_t end)
+		{
+			OutputIterator out = result + begin;
+			for (RandomIterator it = first + begin; it != first + end; ++it, ++out)
+				*out = operation(*it);
+		}
+	};
+
+	template <typename RandomIterator, typename OutputIterator>
+	struct copy_body_
+	{
+		RandomIterator	first;
+		OutputIterator	result;
+
+		void operator()(std::size_t begin, std::size_t end)
+		{ ft::copy(first + begin, first + end, result + begin); }
+	};
+
+	template <typename RandomIterator, typename T, typename BinaryOperation>
+	struct reduce_body_
+	{
+		RandomIterator		first;
+		BinaryOperation		operation;
+		std::size_t			grain;
+		ft::vector<T>*		partials;
+
+		void operator()(std::size_t begin, std::size_t end)
+		{
+			T partial = first[begin];
+			for (RandomIterator it = first + (begin + 1); it != first + end; ++it)
+				partial = operation(partial, *it);
+			(*partials)[begin / grain] = partial;
+		}
+	};
+
+	template <typename RandomIterator, typename Compare>
+	struct sort_body_
+	{
+		RandomIterator	first;
+		Compare			comp;
+
+		void operator()(std::size_t begin, std::size_t end)
+		{ ft::sort(first + begin, first + end, comp); }
+	};
+
+	/*Returns how many of the first @k elements of the merge of the sorted ranges [src + l, src + l + l_len) and
+	[src + r, src + r + r_len) come from the left one, ties going left. Binary search along the merge path.*/
+	template <typename SourceIterator, typename Compare>
+	std::size_t merge_co_rank_(SourceIterator src, std::size_t l, std::size_t l_len, std::size_t r, std::size_t r_len,
+		std::size_t k, Compare comp)
+	{
+		std::size_t low = k > r_len ? k - r_len : 0;
+		std::size_t high = ft::min(k, l_len);
+		while (low < high)
+		{
+			const std::size_t i = low + (high - low) / 2;
+			if (!comp(src[r + (k - i - 1)], src[l + i]))
+				low = i + 1;
+			else
+				high = i;
+		}
+		return low;
+	}
+
+	/*Merges the run pairs of one level of the parallel merge sort. Pair p covers [2p * step, 2(p + 1) * step)
+	and is cut into @pieces parts of equal output size, so that even the last level, a single pair, keeps
+	every worker busy. Task t merges part t % pieces of pair t / pieces; its inputs are found by co-ranking.*/
+	template <typename SourceIterator, typename DestIterator, typename Compare>
+	struct merge_body_
+	{
+		SourceIterator	src;
+		DestIterator	dst;
+		std::size_t		len;
+		std::size_t		step;
+		std::size_t		pieces;
+		Compare			comp;
+
+		void operator()(std::size_t begin, std::size_t end)
+		{
+			for (std::size_t task = begin; task < end; ++task)
+			{
+				const std::size_t run = task / pieces * 2 * step;
+				const std::size_t part = task % pieces;
+				const std::size_t total = ft::min(2 * step, len - run);
+				const std::size_t l_len = ft::min(step, total);
+				const std::size_t r_len = total - l_len;
+				const std::size_t out_begin = total * part / pieces;
+				const std::size_t out_end = total * (part + 1) / pieces;
+				const std::size_t l_begin = merge_co_rank_(src, run, l_len, run + l_len, r_len, out_begin, comp);
+				const std::size_t l_end = merge_co_rank_(src, run, l_len, run + l_len, r_len, out_end, comp);
+				ft::merge_ranges_(src, run + l_begin, run + l_end, run + l_len + (out_begin - l_begin),
+					run + l_len + (out_end - l_end), dst, run + out_begin, comp);
+			}
+		}
+	};
+
+	/***********************************************
+		PARALLEL ALGORITHMS
+	***********************************************/
+
+	/*Applies @f to every element of [first, last) in parallel. Each chunk works on its own copy of @f,
+	so @f must not rely on state shared between calls. @grain is the minimal number of elements per task, 0 chooses one.*/
+	template <typename RandomIterator, typename Function>
+	void parallel_for_each(RandomIterator first, RandomIterator last, Function f,
+		std::size_t grain = 0, thread_pool& pool = thread_pool::instance())
+	{
+		const std::size_t len = static_cast<std::size_t>(last - first);
+		for_each_body_<RandomIterator, Function> body = { first, f };
+		parallel_chunks_(len, resolve_grain_(len, grain, pool), pool, body);
+	}
+
+	/*Stores @op applied to every element of [first, last) in the range beginning at @result, in parallel.*/
+	template <typename RandomIterator, typename OutputIterator, typename UnaryOperation>
+	OutputIterator parallel_transform(RandomIterator first, RandomIterator last, OutputIterator result, UnaryOperation op,
+		std::size_t grain = 0, thread_pool& pool = thread_pool::instance())
+	{
+		const std::size_t len = static_cast<std::size_t>(last - first);
+		transform_body_<RandomIterator, OutputIterator, UnaryOperation> body = { first, result, op };
+		parallel_chunks_(len, resolve_grain_(len, grain, pool), pool, body);
+		return result + len;
+	}
+
+	/*Copies [first, last) to the range beginning at @result, in parallel. The ranges must not overlap.*/
+	template <typename RandomIterator, typename OutputIterator>
+	OutputIterator parallel_copy(RandomIterator first, RandomIterator last, OutputIterator result,
+		std::size_t grain = 0, thread_pool& pool = thread_pool::instance())
+	{
+		const std::size_t len = static_cast<std::size_t>(last - first);
+		copy_body_<RandomIterator, OutputIterator> body = { first, result };
+		parallel_chunks_(len, resolve_grain_(len, grain, pool), pool, body);
+		return result + len;
+	}
+
+	/*Folds [first, last) into @init with @op. Chunks are reduced in parallel, then combined left to right,
+	so @op has to be associative but need not be commutative.*/
+	template <typename RandomIterator, typename T, typename BinaryOperation>
+	T parallel_reduce(RandomIterator first, RandomIterator last, T init, BinaryOperation op,
+		std::size_t grain = 0, thread_pool& pool = thread_pool::instance())
+	{
+		const std::size_t len = static_cast<std::size_t>(last - first);
+		if (len == 0)
+			return init;
+		grain = resolve_grain_(len, grain, pool);
+		ft::vector<T> partials((len + grain - 1) / grain, init);
+		reduce_body_<RandomIterator, T, BinaryOperation> body = { first, op, grain, &partials };
+		parallel_chunks_(len, grain, pool, body);
+		for (std::size_t i = 0; i < partials.size(); ++i)
+			init = op(init, partials[i]);
+		return init;
+	}
+
+	/*Sums up [first, last) starting from @init, in parallel.*/
+	template <typename RandomIterator, typename T>
+	T parallel_reduce(RandomIterator first, RandomIterator last, T init)
+	{ return ft::parallel_reduce(first, last, init, std::plus<T>());}
+
+	/*Sorts [first, last) with respect to @comp in parallel. Chunks of @grain elements are sorted with ft::sort,
+	then merged pairwise level by level through one scratch buffer. Every merge is split along its merge path into
+	tasks of about @grain elements, so all levels run in parallel. The order of equal elements is not preserved.*/
+	template <typename RandomIterator, typename Compare>
+	void parallel_sort(RandomIterator first, RandomIterator last, Compare comp,
+		std::size_t grain = 0, thread_pool& pool = thread_pool::instance())
+	{
+		typedef typename ft::iterator_traits<RandomIterator>::value_type	value_type;
+
+		const std::size_t len = static_cast<std::size_t>(last - first);
+		grain = resolve_grain_(len, grain, pool);
+		sort_body_<RandomIterator, Compare> sorter = { first, comp };
+		parallel_chunks_(len, grain, pool, sorter);
+		if (len <= grain)
+			return ;
+
+		sort_buffer_<value_type> buffer(first, len);
+		bool in_buffer = false;
+		for (std::size_t step = grain; step < len; step *= 2)
+		{
+			const std::size_t pairs = (len + 2 * step - 1) / (2 * step);
+			const std::size_t pieces = 2 * step / grain;
+			if (in_buffer)
+			{
+				merge_body_<value_type*, RandomIterator, Compare> merger = { buffer.data(), first, len, step, pieces, comp };
+				parallel_chunks_(pairs * pieces, 1, pool, merger);
+			}
+			else
+			{
+				merge_body_<RandomIterator, value_type*, Compare> merger = { first, buffer.data(), len, step, pieces, comp };
+				parallel_chunks_(pairs * pieces, 1, pool, merger);
+			}
+			in_buffer = !in_buffer;
+		}
+		if (in_buffer)
+			ft::parallel_copy(buffer.data(), buffer.data() + len, first, grain, pool);
+	}
+
+	/*Sorts [first, last) in ascending order in parallel.*/
+	template <typename RandomIterator>
+	void parallel_sort(RandomIterator first, RandomIterator last)
+	{ ft::parallel_sort(first, last, std::less<typename ft::iterator_traits<RandomIterator>::value_type>());}
+
+	/***********************************************
+		PARALLEL TREE TRAVERSAL
+	***********************************************/
+
+	/*Piece of the in-order decomposition of a tree: a single node, or a node together with its whole subtree*/
+	template <typename NodePointer>
+	struct tree_part_
+	{
+		NodePointer		node;
+		bool			subtree;
+	};
+
+	/*Decomposes the tree below @node into the nodes of its first @depth levels and the subtrees hanging below them,
+	in order. At most 2^@depth subtrees and 2^@depth - 1 single nodes result.*/
+	template <typename NodePointer>
+	void split_tree_(NodePointer node, std::size_t depth, ft::vector<tree_part_<NodePointer> >& parts)
+	{
+		if (node == node->nil)
+			return ;
+		tree_part_<NodePointer> part = { node, depth == 0 };
+		if (depth == 0)
+		{
+			parts.push_back(part);
+			return ;
+		}
+		split_tree_<NodePointer>(node->left, depth - 1, parts);
+		parts.push_back(part);
+		split_tree_<NodePointer>(node->right, depth - 1, parts);
+	}
+
+	/*Applies @f to the values of the subtree below @node in order, without recursion: splayed trees can be deep*/
+	template <typename NodePointer, typename Function>
+	void visit_subtree_(NodePointer node, Function& f)
+	{
+		if (node == node->nil)
+			return ;
+		const NodePointer last = ft::rbt_rightmost(node);
+		for (node = ft::rbt_leftmost(node); node != last; node = ft::rbt_next(node))
+			f(node->value);
+		f(last->value);
+	}
+
+	/*Returns the number of split levels for @pool: enough for about eight subtrees per worker*/
+	inline std::size_t tree_split_depth_(const thread_pool& pool)
+	{
+		std::size_t depth = 3;
+		for (std::size_t parts = pool.size(); parts > 1; parts >>= 1)
+			++depth;
+		return depth;
+	}
+
+	template <typename NodePointer, typename Function>
+	struct tree_for_each_body_
+	{
+		const ft::vector<tree_part_<NodePointer> >*	parts;
+		Function									function;
+
+		void operator()(std::size_t begin, std::size_t end)
+		{
+			Function f(function);
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				if ((*parts)[i].subtree)
+					visit_subtree_<NodePointer>((*parts)[i].node, f);
+				else
+					f((*parts)[i].node->value);
+			}
+		}
+	};
+
+	/*Folds visited values into @value, which starts out as the identity element*/
+	template <typename T, typename Fold>
+	struct tree_fold_
+	{
+		T		value;
+		Fold	fold;
+
+		template <typename Value>
+		void operator()(const Value& v)
+		{ value = fold(value, v); }
+	};
+
+	template <typename NodePointer, typename T, typename Fold>
+	struct tree_reduce_body_
+	{
+		const ft::vector<tree_part_<NodePointer> >*	parts;
+		T											identity;
+		Fold										fold;
+		ft::vector<T>*								partials;
+
+		void operator()(std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				tree_fold_<T, Fold> folder = { identity, fold };
+				if ((*parts)[i].subtree)
+					visit_subtree_<NodePointer>((*parts)[i].node, folder);
+				else
+					folder((*parts)[i].node->value);
+				(*partials)[i] = folder.value;
+			}
+		}
+	};
+
+	/*Applies @f to every value of the tree that contains @any_node, visiting disjoint subtrees concurrently*/
+	template <typename NodePointer, typename Function>
+	void tree_parallel_for_each_(NodePointer any_node, Function f, thread_pool& pool)
+	{
+		if (any_node == any_node->nil)
+			return ;
+		ft::vector<tree_part_<NodePointer> > parts;
+		split_tree_<NodePointer>(ft::rbt_root(any_node), tree_split_depth_(pool), parts);
+		tree_for_each_body_<NodePointer, Function> body = { &parts, f };
+		parallel_chunks_(parts.size(), 1, pool, body);
+	}
+
+	/*Reduces the tree that contains @any_node: every part is folded from @identity with @fold concurrently,
+	then the partial results are combined in order with @combine.*/
+	template <typename NodePointer, typename T, typename Fold, typename Combine>
+	T tree_parallel_reduce_(NodePointer any_node, T identity, Fold fold, Combine combine, thread_pool& pool)
+	{
+		if (any_node == any_node->nil)
+			return identity;
+		ft::vector<tree_part_<NodePointer> > parts;
+		split_tree_<NodePointer>(ft::rbt_root(any_node), tree_split_depth_(pool), parts);
+		ft::vector<T> partials(parts.size(), identity);
+		tree_reduce_body_<NodePointer, T, Fold> body = { &parts, identity, fold, &partials };
+		parallel_chunks_(parts.size(), 1, pool, body);
+		T result = partials[0];
+		for (std::size_t i = 1; i < partials.size(); ++i)
+			result = combine(result, partials[i]);
+		return result;
+	}
+
+	/*Applies @f to every element of @m, visiting disjoint subtrees concurrently.
+	@f receives a value_type& and may modify the mapped values.*/
+	template <typename Key, typename T, typename Compare, typename Allocator, typename Balance, typename Function>
+	void parallel_for_each(ft::map<Key, T, Compare, Allocator, Balance>& m, Function f, thread_pool& pool = thread_pool::instance())
+	{ tree_parallel_for_each_(m.begin().base(), f, pool); }
+
+	/*Applies @f to every element of the read-only @m, visiting disjoint subtrees concurrently.*/
+	template <typename Key, typename T, typename Compare, typename Allocator, typename Balance, typename Function>
+	void parallel_for_each(const ft::map<Key, T, Compare, Allocator, Balance>& m, Function f, thread_pool& pool = thread_pool::instance())
+	{ tree_parallel_for_each_(m.begin().base(), f, pool); }
+
+	/*Applies @f to every element of @s, visiting disjoint subtrees concurrently.*/
+	template <typename Key, typename Compare, typename Allocator, typename Balance, typename Function>
+	void parallel_for_each(const ft::set<Key, Compare, Allocator, Balance>& s, Function f, thread_pool& pool = thread_pool::instance())
+	{ tree_parallel_for_each_(s.begin().base(), f, pool); }
+
+	/*Reduces @m to fold(... fold(identity, e1) ..., en), computed per subtree and joined with @combine.
+	@identity must be neutral for @combine, which has to be associative.*/
+	template <typename Key, typename T, typename Compare, typename Allocator, typename Balance, typename R, typename Fold, typename Combine>
+	R parallel_reduce(const ft::map<Key, T, Compare, Allocator, Balance>& m, R identity, Fold fold, Combine combine,
+		thread_pool& pool = thread_pool::instance())
+	{ return tree_parallel_reduce_(m.begin().base(), identity, fold, combine, pool); }
+
+	/*Reduces @s with @op, which folds elements into the result as well as joining partial results.*/
+	template <typename Key, typename Compare, typename Allocator, typename Balance, typename R, typename Operation>
+	R parallel_reduce(const ft::set<Key, Compare, Allocator, Balance>& s, R identity, Operation op,
+		thread_pool& pool = thread_pool::instance())
+	{ return tree_parallel_reduce_(s.begin().base(), identity, op, op, pool); }
+
+	/*Reduces @s to fold(... fold(identity, e1) ..., en), computed per subtree and joined with @combine.*/
+	template <typename Key, typename Compare, typename Allocator, typename Balance, typename R, typename Fold, typename Combine>
+	R parallel_reduce(const ft::set<Key, Compare, Allocator, Balance>& s, R identity, Fold fold, Combine combine,
+		thread_pool& pool = thread_pool::instance())
+	{ return tree_parallel_reduce_(s.begin().base(), identity, fold, combine, pool); }
+}
\ No newline at end of file
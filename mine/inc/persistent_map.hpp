@@ -0,0 +1,695 @@
+#pragma once
+#include "map.hpp"
+#include "iterator.hpp"
+#include "iterator_traits.hpp"
+#include "rbt_node.hpp"
+#include "utility.hpp"
+#include "algorithm.hpp"
+#include "mynullptr.hpp"
+#include <stdexcept>
+
+namespace ft
+{
+	/***********************************************
+		NODE
+	***********************************************/
+
+	/* Node of a persistent_map. A node can be part of many versions at once, so it has no parent (parent and nil
+	stay null, empty subtrees are null) and counts how many versions and nodes point to it. Nodes are never changed
+	once they are shared; the count is atomic, so versions may be copied and dropped from different threads.*/
+	template <typename T>
+	class persistent_node : public avl_node<T>
+	{
+		public:
+			int	references;
+
+		public:
+			persistent_node* left_child() const { return static_cast<persistent_node*>(this->left); }
+
+			persistent_node* right_child() const { return static_cast<persistent_node*>(this->right); }
+	};
+
+	/***********************************************
+		ITERATOR
+	***********************************************/
+
+	/* Read-only bidirectional iterator of a persistent_map. Without parent pointers it keeps the path from the
+	root to the current node; an empty path is the end. Valid as long as a version containing the node lives.*/
+	template <typename T, typename DIFFTYPE>
+	class persistent_map_iterator
+	{
+		public:
+			typedef T													value_type;
+			typedef const T*											pointer;
+			typedef const T&											reference;
+			typedef DIFFTYPE											difference_type;
+			typedef bidirectional_iterator_tag							iterator_category;
+
+			/*No AVL tree with fewer than 2.7e13 nodes is deeper, see persistent_map::max_size()*/
+			static const int											max_height = 64;
+
+		private:
+			typedef const persistent_node<T>*							const_node_pointer;
+
+			const_node_pointer	root_;
+			const_node_pointer	path_[max_height];
+			int					depth_;
+
+		public:
+			persistent_map_iterator(): root_(mynullptr), depth_(0) {}
+
+			/*Iterator to the end of the tree under @root*/
+			explicit persistent_map_iterator(const_node_pointer root): root_(root), depth_(0) {}
+
+			/*Iterator to the node at the end of the @depth nodes of @path, which starts at the root*/
+			persistent_map_iterator(const_node_pointer root, const const_node_pointer* path, int depth)
+			:root_(root), depth_(depth)
+			{ ft::copy(path, path + depth, path_); }
+
+			persistent_map_iterator(const persistent_map_iterator& other)
+			:root_(other.root_), depth_(other.depth_)
+			{ ft::copy(other.path_, other.path_ + other.depth_, path_); }
+
+			persistent_map_iterator& operator=(const persistent_map_iterator& other)
+			{
+				root_ = other.root_;
+				depth_ = other.depth_;
+				ft::copy(other.path_, other.path_ + other.depth_, path_);
+				return *this;
+			}
+
+			~persistent_map_iterator() {}
+
+			reference operator*() const { return path_[depth_ - 1]->value; }
+
+			pointer operator->() const { return &path_[depth_ - 1]->value; }
+
+			persistent_map_iterator& operator++()
+			{
+				const_node_pointer node = path_[depth_ - 1];
+
+				if (node->right != mynullptr)
+					push_leftmost_(node->right_child());
+				else
+				{
+					while (depth_ > 1 && path_[depth_ - 2]->right == path_[depth_ - 1])
+						--depth_;
+					--depth_;
+				}
+				return *this;
+			}
+
+			persistent_map_iterator operator++(int)
+			{
+				persistent_map_iterator tmp(*this);
+				++(*this);
+				return tmp;
+			}
+
+			persistent_map_iterator& operator--()
+			{
+				if (depth_ == 0)
+				{
+					if (root_ != mynullptr)
+						push_rightmost_(root_);
+					return *this;
+				}
+				const_node_pointer node = path_[depth_ - 1];
+				if (node->left != mynullptr)
+					push_rightmost_(node->left_child());
+				else
+				{
+					while (depth_ > 1 && path_[depth_ - 2]->left == path_[depth_ - 1])
+						--depth_;
+					--depth_;
+				}
+				return *this;
+			}
+
+			persistent_map_iterator operator--(int)
+			{
+				persistent_map_iterator tmp(*this);
+				--(*this);
+				return tmp;
+			}
+
+			/*Iterators are equal if they stand on the same node, or both at the end*/
+			bool operator==(const persistent_map_iterator& other) const
+			{ return current_() == other.current_(); }
+
+			bool operator!=(const persistent_map_iterator& other) const
+			{ return current_() != other.current_(); }
+
+			/*Iterator to the smallest element under @root*/
+			static persistent_map_iterator first(const_node_pointer root)
+			{
+				persistent_map_iterator it(root);
+				if (root != mynullptr)
+					it.push_leftmost_(root);
+				return it;
+			}
+
+		private:
+			const_node_pointer current_() const
+			{ return depth_ == 0 ? mynullptr : path_[depth_ - 1]; }
+
+			void push_leftmost_(const_node_pointer node)
+			{
+				for (; node != mynullptr; node = node->left_child())
+					path_[depth_++] = node;
+			}
+
+			void push_rightmost_(const_node_pointer node)
+			{
+				for (; node != mynullptr; node = node->right_child())
+					path_[depth_++] = node;
+			}
+	};
+
+	/***********************************************
+		PERSISTENT MAP
+	***********************************************/
+
+	/* ft::persistent_map is an immutable map: insert and erase leave the map alone and return a new version.
+	The new version copies only the O(log n) nodes on the path to the changed key and shares all others with the
+	old one (path copying), so keeping many versions costs little and readers of an old version never see later
+	changes. Copying a version is O(1). The tree is AVL balanced: deletion by path copying is simple with heights,
+	and the height already lives in ft::avl_node. Nodes are freed when the last version holding them goes.*/
+	template <typename Key, typename T, typename Compare = std::less<Key>,
+	typename Allocator = std::allocator< ft::pair<const Key, T> > >
+	class persistent_map
+	{
+		public:
+			typedef Key																	key_type;
+			typedef T																	mapped_type;
+			typedef ft::pair<const key_type, mapped_type>								value_type;
+			typedef Compare																key_compare;
+			typedef Allocator															allocator_type;
+			typedef typename allocator_type::const_reference							const_reference;
+			typedef typename allocator_type::const_pointer								const_pointer;
+			typedef typename allocator_type::size_type									size_type;
+			typedef typename allocator_type::difference_type 							difference_type;
+			typedef persistent_map_iterator<value_type, difference_type>				iterator;
+			typedef persistent_map_iterator<value_type, difference_type>				const_iterator;
+			typedef ft::reverse_iterator<const_iterator>								reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>								const_reverse_iterator;
+
+		private:
+			typedef map_value_type_compare<key_type, value_type, key_compare>			value_type_compare;
+			typedef persistent_node<value_type>											node_type;
+			typedef node_type*															node_pointer;
+			typedef const node_type*													const_node_pointer;
+			typedef typename allocator_type::template rebind<node_type>::other			node_allocator_type;
+
+		public:
+			/*Default constructor creates an empty map*/
+			explicit persistent_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+			:compare_size_(value_type_compare(comp), 0), alloc_root_(node_allocator_type(alloc), mynullptr) {}
+
+			/*Builds a version holding the elements of [first, last), the first of equivalent keys wins*/
+			template <class InputIterator>
+			persistent_map(InputIterator first,
+				InputIterator last,
+				const key_compare& comp = key_compare(),
+				const allocator_type& alloc = allocator_type())
+				:compare_size_(value_type_compare(comp), 0), alloc_root_(node_allocator_type(alloc), mynullptr)
+			{
+				for (; first != last; ++first)
+					*this = insert(*first);
+			}
+
+			/*Copies the contents of @m in O(n log n)*/
+			template <typename Balance>
+			explicit persistent_map(const ft::map<key_type, mapped_type, key_compare, allocator_type, Balance>& m)
+			:compare_size_(value_type_compare(m.key_comp()), 0), alloc_root_(node_allocator_type(m.get_allocator()), mynullptr)
+			{
+				typedef typename ft::map<key_type, mapped_type, key_compare, allocator_type, Balance>::const_iterator source_iterator;
+
+				for (source_iterator it = m.begin(); it != m.end(); ++it)
+					*this = insert(*it);
+			}
+
+			/*Shares all nodes of @other, O(1)*/
+			persistent_map(const persistent_map& other)
+			:compare_size_(other.compare_size_), alloc_root_(other.alloc_root_)
+			{ retain_(root_()); }
+
+			~persistent_map()
+			{ release_(root_()); }
+
+			persistent_map& operator=(const persistent_map& other)
+			{
+				if (root_() != other.root_())
+				{
+					retain_(other.root_());
+					release_(root_());
+				}
+				compare_size_ = other.compare_size_;
+				alloc_root_ = other.alloc_root_;
+				return *this;
+			}
+
+		private:
+			/*Stateless comparators and allocators take no space, see red_black_tree*/
+			ft::compressed_pair<value_type_compare, size_type>			compare_size_;
+			ft::compressed_pair<node_allocator_type, node_pointer>		alloc_root_;
+
+			/*Takes ownership of @root, which holds @size elements*/
+			persistent_map(const persistent_map& base, node_pointer root, size_type size)
+			:compare_size_(base.compare_(), size), alloc_root_(base.alloc_node_(), root) {}
+
+			const value_type_compare& compare_() const { return compare_size_.first(); }
+
+			size_type size_() const { return compare_size_.second(); }
+
+			node_allocator_type& alloc_node_() { return alloc_root_.first(); }
+
+			const node_allocator_type& alloc_node_() const { return alloc_root_.first(); }
+
+			node_pointer root_() const { return alloc_root_.second(); }
+
+			static int height_(const_node_pointer node)
+			{ return node == mynullptr ? 0 : node->height; }
+
+			static node_pointer retain_(node_pointer node)
+			{
+				if (node != mynullptr)
+					__sync_fetch_and_add(&node->references, 1);
+				return node;
+			}
+
+			/*Drops one reference to @node. The last one frees it and drops the references to its children;
+			the recursion is bounded by the height of the tree.*/
+			void release_(node_pointer node) const
+			{
+				while (node != mynullptr && __sync_sub_and_fetch(&node->references, 1) == 0)
+				{
+					node_pointer right = node->right_child();
+					release_(node->left_child());
+					destroy_node_(node);
+					node = right;
+				}
+			}
+
+			/*Creates a node of @value over @left and @right, taking over the references the caller holds to them*/
+			node_pointer create_node_(const value_type& value, node_pointer left, node_pointer right) const
+			{
+				node_allocator_type alloc(alloc_node_());
+				allocator_type value_alloc(alloc);
+				node_pointer node = mynullptr;
+
+				try
+				{
+					node = alloc.allocate(1);
+					value_alloc.construct(&node->value, value);
+				}
+				catch (...)
+				{
+					if (node != mynullptr)
+						alloc.deallocate(node, 1);
+					release_(left);
+					release_(right);
+					throw;
+				}
+				node->colour = BLACK;
+				node->references = 1;
+				node->parent = mynullptr;
+				node->nil = mynullptr;
+				node->left = left;
+				node->right = right;
+				node->height = 1 + ft::max(height_(left), height_(right));
+				return node;
+			}
+
+			void destroy_node_(node_pointer node) const
+			{
+				node_allocator_type alloc(alloc_node_());
+				allocator_type value_alloc(alloc);
+
+				value_alloc.destroy(&node->value);
+				alloc.deallocate(node, 1);
+			}
+
+			/*Makes sure the node in @slot is referenced from there only, copying it if it is shared,
+			so that it may be changed. @slot belongs to a node that is not shared itself.*/
+			node_pointer own_(typename node_type::pointer& slot) const
+			{
+				node_pointer node = static_cast<node_pointer>(slot);
+
+				if (__sync_fetch_and_add(&node->references, 0) > 1)
+				{
+					node_pointer copy = create_node_(node->value, retain_(node->left_child()), retain_(node->right_child()));
+					release_(node);
+					slot = copy;
+					return copy;
+				}
+				return node;
+			}
+
+			static void update_height_(node_pointer node)
+			{ node->height = 1 + ft::max(height_(node->left_child()), height_(node->right_child())); }
+
+			/*Rotations of unshared nodes; the references move along with the links*/
+			node_pointer rotate_left_(node_pointer node) const
+			{
+				node_pointer right = own_(node->right);
+				node->right = right->left;
+				right->left = node;
+				update_height_(node);
+				update_height_(right);
+				return right;
+			}
+
+			node_pointer rotate_right_(node_pointer node) const
+			{
+				node_pointer left = own_(node->left);
+				node->left = left->right;
+				left->right = node;
+				update_height_(node);
+				update_height_(left);
+				return left;
+			}
+
+			/*Restores the AVL balance of the fresh node @node, whose subtrees are balanced and differ in height by
+			at most two. Returns the root of the subtree. @node is released if copying a shared child throws.*/
+			node_pointer balance_(node_pointer node) const
+			{
+				try
+				{
+					update_height_(node);
+					const int balance = height_(node->left_child()) - height_(node->right_child());
+					if (balance > 1)
+					{
+						node_pointer left = own_(node->left);
+						if (height_(left->left_child()) < height_(left->right_child()))
+							node->left = rotate_left_(left);
+						return rotate_right_(node);
+					}
+					if (balance < -1)
+					{
+						node_pointer right = own_(node->right);
+						if (height_(right->right_child()) < height_(right->left_child()))
+							node->right = rotate_right_(right);
+						return rotate_left_(node);
+					}
+				}
+				catch (...)
+				{
+					release_(node);
+					throw;
+				}
+				return node;
+			}
+
+			/*Returns the root of a new subtree with @value added, or null if nothing had to change: the key exists
+			and @assign is false. @added tells whether the key is new.*/
+			node_pointer insert_(node_pointer node, const value_type& value, bool assign, bool& added) const
+			{
+				if (node == mynullptr)
+				{
+					added = true;
+					return create_node_(value, mynullptr, mynullptr);
+				}
+				if (compare_()(value, node->value))
+				{
+					node_pointer left = insert_(node->left_child(), value, assign, added);
+					if (left == mynullptr)
+						return mynullptr;
+					return balance_(create_node_(node->value, left, retain_(node->right_child())));
+				}
+				if (compare_()(node->value, value))
+				{
+					node_pointer right = insert_(node->right_child(), value, assign, added);
+					if (right == mynullptr)
+						return mynullptr;
+					return balance_(create_node_(node->value, retain_(node->left_child()), right));
+				}
+				if (!assign)
+					return mynullptr;
+				return create_node_(value, retain_(node->left_child()), retain_(node->right_child()));
+			}
+
+			/*Returns the root of a new subtree without its smallest element, which is stored in @min*/
+			node_pointer erase_min_(node_pointer node, const_node_pointer& min) const
+			{
+				if (node->left == mynullptr)
+				{
+					min = node;
+					return retain_(node->right_child());
+				}
+				node_pointer left = erase_min_(node->left_child(), min);
+				return balance_(create_node_(node->value, left, retain_(node->right_child())));
+			}
+
+			/*Returns the root of a new subtree without @key. Sets @found, nothing is built if it is false.*/
+			node_pointer erase_(node_pointer node, const key_type& key, bool& found) const
+			{
+				if (node == mynullptr)
+				{
+					found = false;
+					return mynullptr;
+				}
+				if (compare_()(key, node->value))
+				{
+					node_pointer left = erase_(node->left_child(), key, found);
+					if (!found)
+						return mynullptr;
+					return balance_(create_node_(node->value, left, retain_(node->right_child())));
+				}
+				if (compare_()(node->value, key))
+				{
+					node_pointer right = erase_(node->right_child(), key, found);
+					if (!found)
+						return mynullptr;
+					return balance_(create_node_(node->value, retain_(node->left_child()), right));
+				}
+				found = true;
+				if (node->left == mynullptr)
+					return retain_(node->right_child());
+				if (node->right == mynullptr)
+					return retain_(node->left_child());
+				const_node_pointer min = mynullptr;
+				node_pointer right = erase_min_(node->right_child(), min);
+				return balance_(create_node_(min->value, retain_(node->left_child()), right));
+			}
+
+			/*Descends to @key and returns the iterator of the first element that is not less (or, if @upper,
+			greater) than @key*/
+			const_iterator bound_(const key_type& key, bool upper) const
+			{
+				const_node_pointer path[const_iterator::max_height];
+				int depth = 0;
+				int bound_depth = 0;
+
+				for (const_node_pointer node = root_(); node != mynullptr; )
+				{
+					path[depth++] = node;
+					if (upper ? compare_()(key, node->value) : !compare_()(node->value, key))
+					{
+						bound_depth = depth;
+						node = node->left_child();
+					}
+					else
+						node = node->right_child();
+				}
+				return const_iterator(root_(), path, bound_depth);
+			}
+
+		public:
+
+			/***********************************************
+				ELEMENT ACCESS
+			***********************************************/
+
+			/*Returns a read-only reference to the mapped value of the element with key equivalent to key.*/
+			const mapped_type& at(const key_type& key) const
+			{
+				const_node_pointer node = find_node_(key);
+				if (node == mynullptr)
+					throw std::out_of_range("key not found");
+				return node->value.second;
+			}
+
+			/***********************************************
+				ITERATORS
+			***********************************************/
+
+			/*Returns an iterator to the element with the smallest key.*/
+			const_iterator begin() const
+			{ return const_iterator::first(root_()); }
+
+			/*Returns an iterator to the element following the last element of the map.*/
+			const_iterator end() const
+			{ return const_iterator(root_()); }
+
+			/*Returns a reverse iterator to the first element of the reversed map.*/
+			const_reverse_iterator rbegin() const
+			{ return const_reverse_iterator(end()); }
+
+			/*Returns a reverse iterator to the element following the last element of the reversed map.*/
+			const_reverse_iterator rend() const
+			{ return const_reverse_iterator(begin()); }
+
+			/***********************************************
+				CAPACITY
+			***********************************************/
+
+			/*Checks if the container has no elements*/
+			bool empty() const
+			{ return size_() == 0; }
+
+			/*Returns the number of elements in the container*/
+			size_type size() const
+			{ return size_(); }
+
+			/*Returns the maximum number of elements. Beyond F(66) - 1 an AVL tree could outgrow the iterator path.*/
+			size_type max_size() const
+			{
+				const double avl_limit = 27777890035287.0;
+				const size_type alloc_limit = alloc_node_().max_size();
+				return alloc_limit < avl_limit ? alloc_limit : static_cast<size_type>(avl_limit);
+			}
+
+			/***********************************************
+				VERSIONS
+			***********************************************/
+
+			/*Returns a version with @val added. If the key exists the version is this one.*/
+			persistent_map insert(const value_type& val) const
+			{
+				bool added = false;
+				node_pointer root = insert_(root_(), val, false, added);
+
+				if (root == mynullptr)
+					return *this;
+				return persistent_map(*this, root, size_() + 1);
+			}
+
+			/*Returns a version that maps @key to @obj, whether the key exists or not*/
+			template <class M>
+			persistent_map insert_or_assign(const key_type& key, const M& obj) const
+			{
+				bool added = false;
+				node_pointer root = insert_(root_(), value_type(key, obj), true, added);
+
+				return persistent_map(*this, root, added ? size_() + 1 : size_());
+			}
+
+			/*Returns a version without @key. If the key does not exist the version is this one.*/
+			persistent_map erase(const key_type& key) const
+			{
+				bool found = false;
+				node_pointer root = erase_(root_(), key, found);
+
+				if (!found)
+					return *this;
+				return persistent_map(*this, root, size_() - 1);
+			}
+
+			/*Returns an empty version with the comparator and allocator of this one*/
+			persistent_map clear() const
+			{ return persistent_map(*this, mynullptr, 0); }
+
+			/*Exchanges the contents of the container with those of other*/
+			void swap(persistent_map& other)
+			{
+				ft::swap(compare_size_, other.compare_size_);
+				ft::swap(alloc_root_, other.alloc_root_);
+			}
+
+			/***********************************************
+				Lookup
+			***********************************************/
+
+			/*Returns the number of elements with key that compares equivalent to the specified argument.*/
+			size_type count(const key_type& key) const
+			{ return find_node_(key) == mynullptr ? 0 : 1; }
+
+			/*Checks if there is an element with key equivalent to key.*/
+			bool contains(const key_type& key) const
+			{ return find_node_(key) != mynullptr; }
+
+			/*Finds an element with key equivalent to key.*/
+			const_iterator find(const key_type& key) const
+			{
+				const_iterator it = lower_bound(key);
+				if (it != end() && compare_()(key, *it))
+					return end();
+				return it;
+			}
+
+			/*Returns a range containing all elements with the given key in the container.*/
+			ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+			{ return ft::make_pair(lower_bound(key), upper_bound(key)); }
+
+			/*Returns an iterator to the first element whose key is not less than @key.*/
+			const_iterator lower_bound(const key_type& key) const
+			{ return bound_(key, false); }
+
+			/*Returns an iterator to the first element whose key is greater than @key.*/
+			const_iterator upper_bound(const key_type& key) const
+			{ return bound_(key, true); }
+
+			/***********************************************
+				OBSERVERS
+			***********************************************/
+
+			/*Returns the function that compares keys*/
+			key_compare key_comp() const
+			{ return compare_().key_comp(); }
+
+			allocator_type get_allocator() const
+			{ return allocator_type(alloc_node_()); }
+
+		private:
+			const_node_pointer find_node_(const key_type& key) const
+			{
+				const_node_pointer node = root_();
+
+				while (node != mynullptr)
+				{
+					if (compare_()(key, node->value))
+						node = node->left_child();
+					else if (compare_()(node->value, key))
+						node = node->right_child();
+					else
+						return node;
+				}
+				return mynullptr;
+			}
+	};
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	inline bool operator==(const persistent_map<Key, T, Compare, Allocator>& lhs,
+						const persistent_map<Key, T, Compare, Allocator>& rhs)
+	{ return (lhs.size() == rhs.size()) && ft::equal(lhs.begin(), lhs.end(), rhs.begin());}
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	inline bool operator!=(const persistent_map<Key, T, Compare, Allocator>& lhs,
+						const persistent_map<Key, T, Compare, Allocator>& rhs)
+	{ return !(lhs == rhs);}
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	inline bool operator<(const persistent_map<Key, T, Compare, Allocator>& lhs,
+						const persistent_map<Key, T, Compare, Allocator>& rhs)
+	{ return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());}
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	inline bool operator<=(const persistent_map<Key, T, Compare, Allocator>& lhs,
+						const persistent_map<Key, T, Compare, Allocator>& rhs)
+	{ return !(rhs < lhs);}
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	inline bool operator>(const persistent_map<Key, T, Compare, Allocator>& lhs,
+						const persistent_map<Key, T, Compare, Allocator>& rhs)
+	{ return rhs < lhs;}
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	inline bool operator>=(const persistent_map<Key, T, Compare, Allocator>& lhs,
+						const persistent_map<Key, T, Compare, Allocator>& rhs)
+	{return !(lhs < rhs);}
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	inline void swap(persistent_map<Key, T, Compare, Allocator>& x, persistent_map<Key, T, Compare, Allocator>& y)
+	{x.swap(y);}
+}
@@ -0,0 +1,438 @@
+#pragma once
+
+#include "rbt_node.hpp"
+#include "rbt_stats.hpp"
+#include "algorithm.hpp"
+
+namespace ft
+{
+	/***********************************************
+		NODE ACCESS
+	***********************************************/
+
+	/* The rotations and balancing policies below reach the links and balancing data of a node through an access
+	object, so that trees linked by pointers and trees linked by arena indices share them. An access provides
+		parent(x), left(x), right(x)	references to the links of x
+		colour(x)						reference to the colour of x
+		height(x)						reference to the subtree height of x, only needed by avl_balance
+		nil(x)							the sentinel of the tree of x
+	rbt_pointer_access serves ft::Node and ft::avl_node, whose links are ft::Node pointers; height(x) is only
+	instantiated for avl_node. compact_tree brings its own access for its index links.*/
+	template <class NodeType>
+	struct rbt_pointer_access
+	{
+		typedef typename NodeType::pointer	NodePointer;
+
+		NodePointer& parent(NodePointer x) const { return x->parent; }
+
+		NodePointer& left(NodePointer x) const { return x->left; }
+
+		NodePointer& right(NodePointer x) const { return x->right; }
+
+		COLOUR& colour(NodePointer x) const { return x->colour; }
+
+		int& height(NodePointer x) const { return static_cast<NodeType*>(x)->height; }
+
+		NodePointer nil(NodePointer x) const { return x->nil; }
+	};
+
+	/***********************************************
+		ROTATIONS
+	***********************************************/
+
+	/*Rotates the subtree rooted at @x to the left. @root is updated if @x was the root.*/
+	template <class NodePointer, class Access>
+	void rbt_rotate_left(NodePointer x, NodePointer& root, const tree_counters& counters, const Access& access)
+	{
+		counters.rotated();
+		NodePointer y = access.right(x);
+		access.right(x) = access.left(y);						// turn y's subtree in x's subtree
+		if (access.left(y) != access.nil(x))
+			access.parent(access.left(y)) = x;
+		access.parent(y) = access.parent(x);
+		if (access.parent(x) == access.nil(x))					// if x is root
+			root = y;
+		else if (x == access.left(access.parent(x)))			// or x is left child
+			access.left(access.parent(x)) = y;
+		else													// or x is right child
+			access.right(access.parent(x)) = y;
+		access.left(y) = x;										// put x on y's left
+		access.parent(x) = y;
+	}
+
+	/*Rotates the subtree rooted at @x to the right. @root is updated if @x was the root.*/
+	template <class NodePointer, class Access>
+	void rbt_rotate_right(NodePointer x, NodePointer& root, const tree_counters& counters, const Access& access)
+	{
+		counters.rotated();
+		NodePointer y = access.left(x);
+		access.left(x) = access.right(y);						// turn y's subtree in x's subtree
+		if (access.right(y) != access.nil(x))
+			access.parent(access.right(y)) = x;
+		access.parent(y) = access.parent(x);
+		if (access.parent(x) == access.nil(x))					// if x is root
+			root = y;
+		else if (x == access.right(access.parent(x)))			// or x is right child
+			access.right(access.parent(x)) = y;
+		else													// or x is left child
+			access.left(access.parent(x)) = y;
+		access.right(y) = x;									// put x on y's right
+		access.parent(x) = y;
+	}
+
+	/*Puts the subtree @y in the place of the subtree @x. @root is updated if @x was the root.*/
+	template <class NodePointer, class Access>
+	void rbt_transplant(NodePointer x, NodePointer y, NodePointer& root, const Access& access)
+	{
+		if (access.parent(x) == access.nil(x))
+			root = y;
+		else if (x == access.left(access.parent(x)))			// x is left child
+			access.left(access.parent(x)) = y;
+		else													// x is right child
+			access.right(access.parent(x)) = y;
+		access.parent(y) = access.parent(x);
+	}
+
+	/* Balancing policies of red_black_tree. node<T>::type is the node type the tree allocates, so balancing data
+	only the policy uses lives there. The tree does the plain binary search tree work and calls the policy at six
+	points, passing its node access as the last argument:
+		created(x)								x is a fresh node or sentinel: set up its balancing data
+		copied(source, target)					target is a copy of source: copy the balancing data other than the colour
+		swap_state(y, z)						y is about to take the place of the erased node z: exchange their balancing data
+		inserted(node, root, counters)			node was linked in as a leaf
+		erased(z, x, x_parent, root, counters)	z was unlinked, x (possibly nil) took its place below x_parent
+		accessed(node, root, counters)			a non-const lookup found node
+	Every function may rotate with rbt_rotate_left/rbt_rotate_right and must keep @root up to date. Rotations are
+	counted in @counters by the rotate functions, rebalancing steps by the policy itself.*/
+
+	/***********************************************
+		RED-BLACK
+	***********************************************/
+
+	/* Red-black balancing, the default. Height at most 2 log(n + 1), at most three rotations per update.
+	compact_tree uses it too, through its index access.*/
+	struct red_black_balance
+	{
+		template <class T>
+		struct node { typedef Node<T> type; };
+
+		template <class NodePointer, class Access>
+		static void created(NodePointer, const Access&) {}
+
+		template <class NodePointer, class Access>
+		static void copied(NodePointer, NodePointer, const Access&) {}
+
+		template <class NodePointer, class Access>
+		static void swap_state(NodePointer y, NodePointer z, const Access& access)
+		{ ft::swap(access.colour(y), access.colour(z)); }
+
+		template <class NodePointer, class Access>
+		static void inserted(NodePointer node, NodePointer& root, const tree_counters& counters, const Access& access)
+		{
+			while (node != root && access.colour(access.parent(node)) == RED)
+			{
+				counters.insert_fixup();
+				NodePointer grandparent = access.parent(access.parent(node));
+				if (access.left(grandparent) == access.parent(node))
+				{
+					NodePointer uncle = access.right(grandparent);
+					if (access.colour(uncle) == RED)
+					{
+						access.colour(uncle) = BLACK;
+						access.colour(access.parent(node)) = BLACK;
+						access.colour(grandparent) = RED;
+						node = grandparent;
+					}
+					else
+					{
+						if (node == access.right(access.parent(node)))
+						{
+							node = access.parent(node);
+							rbt_rotate_left(node, root, counters, access);
+						}
+						access.colour(access.parent(node)) = BLACK;
+						access.colour(access.parent(access.parent(node))) = RED;
+						rbt_rotate_right(access.parent(access.parent(node)), root, counters, access);
+					}
+				}
+				else
+				{
+					NodePointer uncle = access.left(grandparent);
+					if (access.colour(uncle) == RED)
+					{
+						access.colour(uncle) = BLACK;
+						access.colour(access.parent(node)) = BLACK;
+						access.colour(grandparent) = RED;
+						node = grandparent;
+					}
+					else
+					{
+						if (node == access.left(access.parent(node)))
+						{
+							node = access.parent(node);
+							rbt_rotate_right(node, root, counters, access);
+						}
+						access.colour(access.parent(node)) = BLACK;
+						access.colour(access.parent(access.parent(node))) = RED;
+						rbt_rotate_left(access.parent(access.parent(node)), root, counters, access);
+					}
+				}
+			}
+			access.colour(root) = BLACK;
+		}
+
+		template <class NodePointer, class Access>
+		static void erased(NodePointer z, NodePointer node, NodePointer x_parent, NodePointer& root,
+			const tree_counters& counters, const Access& access)
+		{
+			if (access.colour(z) != BLACK)
+				return ;
+			access.parent(node) = x_parent;			// nil included, the loop below walks up from it
+			NodePointer sibling;
+			while (node != root && access.colour(node) == BLACK)
+			{
+				counters.erase_fixup();
+				NodePointer parent = access.parent(node);
+				if (node == access.left(parent))
+				{
+					sibling = access.right(parent);
+					if (access.colour(sibling) == RED)
+					{
+						access.colour(sibling) = BLACK;
+						access.colour(parent) = RED;
+						rbt_rotate_left(parent, root, counters, access);
+						sibling = access.right(parent);
+					}
+					if (access.colour(access.left(sibling)) == BLACK && access.colour(access.right(sibling)) == BLACK)
+					{
+						access.colour(sibling) = RED;
+						node = parent;
+					}
+					else
+					{
+						if (access.colour(access.right(sibling)) == BLACK)
+						{
+							access.colour(access.left(sibling)) = BLACK;
+							access.colour(sibling) = RED;
+							rbt_rotate_right(sibling, root, counters, access);
+							sibling = access.right(parent);
+						}
+						access.colour(sibling) = access.colour(parent);
+						access.colour(parent) = BLACK;
+						access.colour(access.right(sibling)) = BLACK;
+						rbt_rotate_left(parent, root, counters, access);
+						node = root;
+					}
+				}
+				else
+				{
+					sibling = access.left(parent);
+					if (access.colour(sibling) == RED)
+					{
+						access.colour(sibling) = BLACK;
+						access.colour(parent) = RED;
+						rbt_rotate_right(parent, root, counters, access);
+						sibling = access.left(parent);
+					}
+					if (access.colour(access.left(sibling)) == BLACK && access.colour(access.right(sibling)) == BLACK)
+					{
+						access.colour(sibling) = RED;
+						node = parent;
+					}
+					else
+					{
+						if (access.colour(access.left(sibling)) == BLACK)
+						{
+							access.colour(access.right(sibling)) = BLACK;
+							access.colour(sibling) = RED;
+							rbt_rotate_left(sibling, root, counters, access);
+							sibling = access.left(parent);
+						}
+						access.colour(sibling) = access.colour(parent);
+						access.colour(parent) = BLACK;
+						access.colour(access.left(sibling)) = BLACK;
+						rbt_rotate_right(parent, root, counters, access);
+						node = root;
+					}
+				}
+			}
+			access.colour(node) = BLACK;
+		}
+
+		template <class NodePointer, class Access>
+		static void accessed(NodePointer, NodePointer&, const tree_counters&, const Access&) {}
+	};
+
+	/***********************************************
+		AVL
+	***********************************************/
+
+	/* AVL balancing. Subtree heights differ by at most one, so the tree is at most 1.44 log(n) high: lookups
+	visit fewer nodes than with red-black balancing, updates rotate more. The height of every subtree is kept
+	in avl_node::height.*/
+	struct avl_balance
+	{
+		template <class T>
+		struct node { typedef avl_node<T> type; };
+
+		/*The sentinel stands for the empty subtree of height 0, a fresh node is a leaf of height 1*/
+		template <class NodePointer, class Access>
+		static void created(NodePointer x, const Access& access)
+		{ access.height(x) = (x == access.nil(x)) ? 0 : 1; }
+
+		template <class NodePointer, class Access>
+		static void copied(NodePointer source, NodePointer target, const Access& access)
+		{ access.height(target) = access.height(source); }
+
+		template <class NodePointer, class Access>
+		static void swap_state(NodePointer y, NodePointer z, const Access& access)
+		{ ft::swap(access.height(y), access.height(z)); }
+
+		template <class NodePointer, class Access>
+		static void inserted(NodePointer node, NodePointer& root, const tree_counters& counters, const Access& access)
+		{ counters.insert_fixup(retrace_(access.parent(node), root, counters, access)); }
+
+		template <class NodePointer, class Access>
+		static void erased(NodePointer, NodePointer, NodePointer x_parent, NodePointer& root,
+			const tree_counters& counters, const Access& access)
+		{ counters.erase_fixup(retrace_(x_parent, root, counters, access)); }
+
+		template <class NodePointer, class Access>
+		static void accessed(NodePointer, NodePointer&, const tree_counters&, const Access&) {}
+
+		private:
+			template <class NodePointer, class Access>
+			static void update_(NodePointer node, const Access& access)
+			{ access.height(node) = 1 + ft::max(access.height(access.left(node)), access.height(access.right(node))); }
+
+			/*Restores the heights and the balance from @node up to the root. Stops at the first subtree
+			whose height did not change, as nothing above it did either. Returns the number of nodes visited.*/
+			template <class NodePointer, class Access>
+			static std::size_t retrace_(NodePointer node, NodePointer& root, const tree_counters& counters,
+				const Access& access)
+			{
+				std::size_t steps = 0;
+				while (node != access.nil(node))
+				{
+					++steps;
+					const int old_height = access.height(node);
+					update_(node, access);
+					const int balance = access.height(access.left(node)) - access.height(access.right(node));
+					if (balance > 1)
+					{
+						NodePointer left = access.left(node);
+						if (access.height(access.left(left)) < access.height(access.right(left)))
+						{
+							rbt_rotate_left(left, root, counters, access);
+							update_(left, access);
+							update_(access.parent(left), access);
+						}
+						rbt_rotate_right(node, root, counters, access);
+						update_(node, access);
+						node = access.parent(node);
+						update_(node, access);
+					}
+					else if (balance < -1)
+					{
+						NodePointer right = access.right(node);
+						if (access.height(access.right(right)) < access.height(access.left(right)))
+						{
+							rbt_rotate_right(right, root, counters, access);
+							update_(right, access);
+							update_(access.parent(right), access);
+						}
+						rbt_rotate_left(node, root, counters, access);
+						update_(node, access);
+						node = access.parent(node);
+						update_(node, access);
+					}
+					if (access.height(node) == old_height)
+						break ;
+					node = access.parent(node);
+				}
+				return steps;
+			}
+	};
+
+	/***********************************************
+		SPLAY
+	***********************************************/
+
+	/* Splay balancing. Every inserted or found node is rotated up to the root, so frequently used keys stay near
+	the top and skewed access patterns get short searches. No balance is guaranteed for a single operation,
+	only O(log n) amortized. Lookups through a non-const map restructure the tree: such a map must not be
+	searched from several threads at once.*/
+	struct splay_balance
+	{
+		template <class T>
+		struct node { typedef Node<T> type; };
+
+		template <class NodePointer, class Access>
+		static void created(NodePointer, const Access&) {}
+
+		template <class NodePointer, class Access>
+		static void copied(NodePointer, NodePointer, const Access&) {}
+
+		template <class NodePointer, class Access>
+		static void swap_state(NodePointer, NodePointer, const Access&) {}
+
+		template <class NodePointer, class Access>
+		static void inserted(NodePointer node, NodePointer& root, const tree_counters& counters, const Access& access)
+		{ counters.insert_fixup(splay_(node, root, counters, access)); }
+
+		template <class NodePointer, class Access>
+		static void erased(NodePointer, NodePointer, NodePointer x_parent, NodePointer& root,
+			const tree_counters& counters, const Access& access)
+		{
+			if (x_parent != access.nil(x_parent))
+				counters.erase_fixup(splay_(x_parent, root, counters, access));
+		}
+
+		template <class NodePointer, class Access>
+		static void accessed(NodePointer node, NodePointer& root, const tree_counters& counters, const Access& access)
+		{ splay_(node, root, counters, access); }
+
+		private:
+			/*Rotates @node up to the root. Returns the number of zig, zig-zig and zig-zag steps.*/
+			template <class NodePointer, class Access>
+			static std::size_t splay_(NodePointer node, NodePointer& root, const tree_counters& counters,
+				const Access& access)
+			{
+				std::size_t steps = 0;
+				while (access.parent(node) != access.nil(node))
+				{
+					++steps;
+					NodePointer parent = access.parent(node);
+					NodePointer grandparent = access.parent(parent);
+					if (grandparent == access.nil(node))									// zig
+					{
+						if (node == access.left(parent))
+							rbt_rotate_right(parent, root, counters, access);
+						else
+							rbt_rotate_left(parent, root, counters, access);
+					}
+					else if (node == access.left(parent) && parent == access.left(grandparent))		// zig-zig
+					{
+						rbt_rotate_right(grandparent, root, counters, access);
+						rbt_rotate_right(parent, root, counters, access);
+					}
+					else if (node == access.right(parent) && parent == access.right(grandparent))
+					{
+						rbt_rotate_left(grandparent, root, counters, access);
+						rbt_rotate_left(parent, root, counters, access);
+					}
+					else if (node == access.left(parent))									// zig-zag
+					{
+						rbt_rotate_right(parent, root, counters, access);
+						rbt_rotate_left(grandparent, root, counters, access);
+					}
+					else
+					{
+						rbt_rotate_left(parent, root, counters, access);
+						rbt_rotate_right(grandparent, root, counters, access);
+					}
+				}
+				return steps;
+			}
+	};
+}
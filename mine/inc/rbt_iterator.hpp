@@ -23,6 +23,14 @@ namespace ft
 		return node;
 	}
 
+	template <class NodePointer>
+	NodePointer rbt_root(NodePointer node)
+	{
+		while (node->parent != node->nil)
+			node = node->parent;
+		return node;
+	}
+
 	template <class NodePointer>
 	NodePointer rbt_next(NodePointer node)
 	{
@@ -41,4 +41,26 @@ namespace ft
 			Node(const Node& other)
 			:value(other.value), colour(other.colour), parent(other.parent), left(other.left), right(other.right), nil(mynullptr) {}
 	};
+
+	/* Node of an avl_balance tree: an ft::Node that also keeps the height of its subtree. Only AVL trees pay for
+	the field, red_black_tree takes its node type from the balancing policy. Links stay ft::Node pointers.*/
+	template <typename T>
+	class avl_node : public Node<T>
+	{
+		public:
+			int			height;		// height of the subtree, 0 for nil
+
+		public:
+			/*Default Constructor instanciating empty node*/
+			avl_node()
+			:Node<T>(), height(0) {}
+
+			/*Constructor initializing value with @value, colour with @colour*/
+			avl_node(T value, COLOUR colour)
+			:Node<T>(value, colour), height(1) {}
+
+			/*Copy Constructor*/
+			avl_node(const avl_node& other)
+			:Node<T>(other), height(other.height) {}
+	};
 }
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+
+namespace ft
+{
+	/* Snapshot of what a red_black_tree has done and what it looks like, returned by map::stats() and set::stats().
+	The counters are only collected if the code is compiled with FT_TREE_STATS defined; otherwise they stay zero
+	and cost nothing. height and black_height are measured on request in either case.
+	Stats builds are single-threaded only: with FT_TREE_STATS even const lookups write to the counters.*/
+	struct tree_stats
+	{
+		bool			counting;			// whether FT_TREE_STATS was defined
+		std::size_t		comparisons;		// comparator calls of inserts and lookups
+		std::size_t		rotations;			// single rotations done by the balancing policy
+		std::size_t		insert_fixups;		// rebalancing steps after insertions
+		std::size_t		erase_fixups;		// rebalancing steps after erasures
+		std::size_t		height;				// nodes on the longest root to leaf path
+		std::size_t		black_height;		// black nodes on a root to leaf path, meaningful for red_black_balance
+
+		tree_stats()
+		:counting(false), comparisons(0), rotations(0), insert_fixups(0), erase_fixups(0), height(0), black_height(0)
+		{ }
+	};
+
+#ifdef FT_TREE_STATS
+	/* Event counters of one tree. They are mutable so that const lookups can count their comparisons.
+	They are plain, unsynchronised integers: a stats build is single-threaded only. Concurrent const lookups,
+	which are safe otherwise, race on the counters once FT_TREE_STATS is defined.*/
+	class tree_counters
+	{
+		public:
+			tree_counters(): comparisons_(0), rotations_(0), insert_fixups_(0), erase_fixups_(0) {}
+
+			void compared() const { ++comparisons_; }
+
+			void rotated() const { ++rotations_; }
+
+			void insert_fixup(std::size_t steps = 1) const { insert_fixups_ += steps; }
+
+			void erase_fixup(std::size_t steps = 1) const { erase_fixups_ += steps; }
+
+			void reset() { *this = tree_counters(); }
+
+			/*Copies the counters into @stats*/
+			void fill(tree_stats& stats) const
+			{
+				stats.counting = true;
+				stats.comparisons = comparisons_;
+				stats.rotations = rotations_;
+				stats.insert_fixups = insert_fixups_;
+				stats.erase_fixups = erase_fixups_;
+			}
+
+		private:
+			mutable std::size_t		comparisons_;
+			mutable std::size_t		rotations_;
+			mutable std::size_t		insert_fixups_;
+			mutable std::size_t		erase_fixups_;
+	};
+#else
+	/* Event counters of one tree, disabled: an empty class whose calls compile to nothing.
+	Define FT_TREE_STATS to collect them.*/
+	class tree_counters
+	{
+		public:
+			void compared() const {}
+
+			void rotated() const {}
+
+			void insert_fixup(std::size_t = 1) const {}
+
+			void erase_fixup(std::size_t = 1) const {}
+
+			void reset() {}
+
+			void fill(tree_stats&) const {}
+	};
+#endif
+}
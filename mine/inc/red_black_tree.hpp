@@ -3,21 +3,27 @@
 #include "mynullptr.hpp"
 #include "iterator.hpp"
 #include "rbt_iterator.hpp"
+#include "rbt_balance.hpp"
+#include "rbt_stats.hpp"
 #include "utility.hpp"
+#include "algorithm.hpp"
 #include <memory>
 #include <iostream>
 
 namespace ft
 {
-	template <typename T, typename COMPARE, typename Allocator >
+	/* Binary search tree behind map and set. @Balance is the balancing policy, see rbt_balance.hpp:
+	red_black_balance by default, avl_balance or splay_balance.*/
+	template <typename T, typename COMPARE, typename Allocator, typename Balance = red_black_balance>
 	class red_black_tree
 	{
 		public:
 			typedef T															value_type;
 			typedef COMPARE														value_compare;
 			typedef Allocator													allocator_type;
+			typedef Balance														balance_type;
 
-			typedef Node<value_type>											node_type;
+			typedef typename balance_type::template node<value_type>::type		node_type;
 			typedef typename allocator_type::template rebind<node_type>::other 	node_allocator_type;
 
 			typedef typename node_type::pointer									node_pointer;
@@ -33,45 +39,80 @@ namespace ft
 			typedef ft::reverse_iterator<iterator>								reverse_iterator;
 			typedef ft::reverse_iterator<const_iterator>						const_reverse_iterator;
 
+			/*Number of lookups find_batch interleaves*/
+			static const size_type batch_width = 8;
+
 		protected:
-			value_compare				compare_;
-			node_allocator_type			alloc_node_;
-			allocator_type				alloc_value_;
-			size_type					node_count_;
-			node_pointer				left_most_;
-			node_pointer				root_;
-			node_pointer				nil_;
+			/*Stateless comparators and allocators take no space: each shares a compressed_pair with a data member*/
+			typedef ft::compressed_pair<allocator_type, node_pointer>			value_alloc_pair_;
+			typedef ft::compressed_pair<tree_counters, size_type>				counters_count_pair_;
+			/*How the balancing policy reaches the links of a node, see rbt_balance.hpp*/
+			typedef ft::rbt_pointer_access<node_type>							node_access_;
+
+			ft::compressed_pair<value_compare, counters_count_pair_>			compare_count_;
+			ft::compressed_pair<node_allocator_type, value_alloc_pair_>			alloc_left_most_;
+			node_pointer														root_;
+			node_pointer														nil_;
+
+			value_compare& compare_() { return compare_count_.first(); }
+
+			const value_compare& compare_() const { return compare_count_.first(); }
+
+			size_type& node_count_() { return compare_count_.second().second(); }
+
+			const size_type& node_count_() const { return compare_count_.second().second(); }
+
+			tree_counters& counters_() { return compare_count_.second().first(); }
+
+			const tree_counters& counters_() const { return compare_count_.second().first(); }
+
+			/*Calls the comparator, counting the call if FT_TREE_STATS is defined*/
+			template <typename Lhs, typename Rhs>
+			bool less_(const Lhs& lhs, const Rhs& rhs) const
+			{
+				counters_().compared();
+				return compare_()(lhs, rhs);
+			}
+
+			node_allocator_type& alloc_node_() { return alloc_left_most_.first(); }
+
+			const node_allocator_type& alloc_node_() const { return alloc_left_most_.first(); }
+
+			allocator_type& alloc_value_() { return alloc_left_most_.second().first(); }
+
+			const allocator_type& alloc_value_() const { return alloc_left_most_.second().first(); }
+
+			node_pointer& left_most_() { return alloc_left_most_.second().second(); }
+
+			node_pointer left_most_() const { return alloc_left_most_.second().second(); }
 		
 		public:	
 
 			node_pointer root_node() { return root_; }
 
 			red_black_tree(const red_black_tree& other)
-			:compare_(other.compare_),
-			alloc_node_(other.alloc_node_),
-			alloc_value_(other.alloc_value_),
-			node_count_(other.node_count_)
+			:compare_count_(other.compare_(), counters_count_pair_(tree_counters(), other.node_count_())),
+			alloc_left_most_(other.alloc_node_(), value_alloc_pair_(other.alloc_value_(), mynullptr))
 			{
-				left_most_ = root_ = nil_ = create_nil_();
+				left_most_() = root_ = nil_ = create_nil_();
 				*this = other;
 			}
 
 			red_black_tree(const value_compare& compare, const allocator_type& alloc)
-			:compare_(compare), alloc_node_(alloc), alloc_value_(alloc), node_count_(0)
+			:compare_count_(compare, counters_count_pair_(tree_counters(), 0)), alloc_left_most_(node_allocator_type(alloc), value_alloc_pair_(alloc, mynullptr))
 			{ 
-				left_most_ = root_ = nil_ = create_nil_();
+				left_most_() = root_ = nil_ = create_nil_();
 			}
 
 			red_black_tree& operator=(const red_black_tree& other)
 			{
 				if (this != &other)
 				{
-					alloc_node_ = other.alloc_node_;
-					alloc_value_ = other.alloc_value_;
 					clear();
-					root_ = tree_copy_(other.root_, nil_, other.nil_);
-					node_count_ = other.node_count_;
-					left_most_ = rbt_leftmost(root_);
+					copy_allocator_(other, ft::allocator_propagates<allocator_type>());
+					root_ = tree_copy_(other.root_, other.nil_);
+					node_count_() = other.node_count_();
+					left_most_() = rbt_leftmost(root_);
 					nil_->parent = rbt_rightmost(root_);
 				}
 				return *this;
@@ -80,17 +121,16 @@ namespace ft
 			~red_black_tree()
 			{
 				clear();
-				alloc_node_.destroy(nil_);
-				alloc_node_.deallocate(nil_, 1);
+				destroy_nil_();
 			}
 
 			/***********************************************
 				Iterators
 			***********************************************/
 			
-			iterator begin() { return iterator(left_most_);}
+			iterator begin() { return iterator(left_most_());}
 
-			const_iterator begin() const { return const_iterator(left_most_);}
+			const_iterator begin() const { return const_iterator(left_most_());}
 
 			iterator end() { return iterator(nil_);}
 	
@@ -100,236 +140,287 @@ namespace ft
 				Capacity
 			***********************************************/
 
-			size_type size() const { return node_count_; }
+			size_type size() const { return node_count_(); }
+
+			size_type max_size() const { return alloc_node_().max_size(); }
+
+			bool empty() const { return node_count_() == 0 ;}
+
+			/*Returns the number of nodes on the longest path from the root to a leaf. Walks the whole tree.*/
+			size_type height() const
+			{
+				size_type height = 0;
+				size_type depth = 1;
+				const_node_pointer node = root_;
+
+				if (node == nil_)
+					return 0;
+				for (; node->left != nil_; ++depth)
+					node = node->left;
+				while (node != nil_)
+				{
+					height = ft::max(height, depth);
+					if (node->right != nil_)
+					{
+						node = node->right;
+						for (++depth; node->left != nil_; ++depth)
+							node = node->left;
+					}
+					else
+					{
+						for (; node->parent != nil_ && node == node->parent->right; --depth)
+							node = node->parent;
+						node = node->parent;
+						--depth;
+					}
+				}
+				return height;
+			}
+
+			/*Returns the number of black nodes on the path from the root to the leftmost leaf. In a red-black
+			tree every root to leaf path has as many.*/
+			size_type black_height() const
+			{
+				size_type black_height = 0;
+
+				for (const_node_pointer node = root_; node != nil_; node = node->left)
+					if (node->colour == BLACK)
+						++black_height;
+				return black_height;
+			}
+
+			/*Returns the counters collected so far together with the current height and black height.
+			The counters stay zero unless FT_TREE_STATS is defined.*/
+			tree_stats stats() const
+			{
+				tree_stats stats;
 
-			size_type max_size() const { return alloc_node_.max_size(); }
+				counters_().fill(stats);
+				stats.height = height();
+				stats.black_height = black_height();
+				return stats;
+			}
 
-			bool empty() const { return node_count_ == 0 ;}
+			/*Sets the counters back to zero*/
+			void reset_stats()
+			{ counters_().reset(); }
 
 			/***********************************************
 				GETTERS
 			***********************************************/
 			
 			allocator_type get_allocator() const
-			{ return alloc_value_;}
+			{ return alloc_value_();}
 		private:
 
 			node_pointer create_nil_()
 			{
-				nil_ = alloc_node_.allocate(1);
-				alloc_value_.construct(&nil_->value, value_type());
-				nil_->colour = BLACK;	
+				nil_ = alloc_node_().allocate(1);
+				alloc_value_().construct(&nil_->value, value_type());
+				nil_->colour = BLACK;
 				nil_->parent = nil_;
 				nil_->left = nil_;
 				nil_->right = nil_;
 				nil_->nil = nil_;
+				balance_type::created(nil_, node_access_());
 				return nil_;
 			}
 
+			void destroy_nil_()
+			{
+				alloc_node_().destroy(static_cast<node_type*>(nil_));
+				alloc_node_().deallocate(static_cast<node_type*>(nil_), 1);
+			}
+
+			/*Takes over the allocators of @other on copy assignment, the tree being empty. A sentinel from an
+			allocator that does not compare equal is returned to it and made anew from the new one.*/
+			void copy_allocator_(const red_black_tree& other, ft::true_type)
+			{
+				const bool equal = alloc_node_() == other.alloc_node_();
+
+				if (!equal)
+					destroy_nil_();
+				alloc_node_() = other.alloc_node_();
+				alloc_value_() = other.alloc_value_();
+				if (!equal)
+					left_most_() = root_ = create_nil_();
+			}
+
+			/*Keeps the own allocators on copy assignment*/
+			void copy_allocator_(const red_black_tree&, ft::false_type) {}
+
+			void swap_allocator_(red_black_tree& other, ft::true_type)
+			{
+				ft::swap(alloc_node_(), other.alloc_node_());
+				ft::swap(alloc_value_(), other.alloc_value_());
+			}
+
+			void swap_allocator_(red_black_tree&, ft::false_type) {}
+
 			node_pointer create_new_node_(const value_type& value, COLOUR colour, node_pointer parent)
 			{
-				node_pointer new_node = alloc_node_.allocate(1);
-				alloc_value_.construct(&new_node->value, value);
+				node_pointer new_node = alloc_node_().allocate(1);
+				alloc_value_().construct(&new_node->value, value);
 				new_node->colour = colour;
 				new_node->parent = parent;
 				new_node->left = nil_;
 				new_node->right = nil_;
 				new_node->nil = nil_;
+				balance_type::created(new_node, node_access_());
 				return new_node;
 			}
 
-			node_pointer tree_copy_(node_pointer node, node_pointer parent, node_pointer nil)
+			/*Copies the tree under @node, whose sentinel is @nil, and returns the root of the copy.
+			Iterative, as splayed trees can be far deeper than the stack allows recursion.*/
+			node_pointer tree_copy_(node_pointer node, node_pointer nil)
 			{
 				if (node == nil)
 					return nil_;
-				node_pointer new_node = create_new_node_(node->value, node->colour, parent);
-				new_node->right = tree_copy_(node->right, new_node, nil);
-				new_node->left = tree_copy_(node->left, new_node, nil);
-				return new_node;
-			}
-
-			void rotate_right_(node_pointer x)
-			{
-				node_pointer y = x->left;
-				x->left = y->right;					// turn y's subtree in x's subtree
-				if (y->right != nil_)
-					y->right->parent = x;
-				y->parent = x->parent;
-				if (x->parent == nil_)				// if x is root
-					root_ = y;
-				else if (x == x->parent->right)		// or x is left child
-					x->parent->right = y;
-				else								// or x is right child
-					x->parent->left = y;
-				y->right = x;						//put x on y's left
-				x->parent = y;
-			}
-
-			void rotate_left_(node_pointer x)
-			{
-				node_pointer y = x->right;
-				x->right = y->left;					// turn y's subtree in x's subtree
-				if (y->left != nil_)
-					y->left->parent = x;
-				y->parent = x->parent;
-				if (x->parent == nil_)				// if x is root
-					root_ = y;
-				else if (x == x->parent->left)		// or x is left child
-					x->parent->left = y;
-				else								// or x is right child
-					x->parent->right = y;
-				y->left = x;						//put x on y's left
-				x->parent = y;
+				node_pointer copy = copy_node_(node, nil_);
+				node_pointer source = node;
+				node_pointer target = copy;
+				while (true)
+				{
+					if (source->left != nil && target->left == nil_)
+					{
+						source = source->left;
+						target = target->left = copy_node_(source, target);
+					}
+					else if (source->right != nil && target->right == nil_)
+					{
+						source = source->right;
+						target = target->right = copy_node_(source, target);
+					}
+					else if (source == node)
+						return copy;
+					else
+					{
+						source = source->parent;
+						target = target->parent;
+					}
+				}
 			}
 
-			void transplant_(node_pointer x, node_pointer y)
+			node_pointer copy_node_(node_pointer node, node_pointer parent)
 			{
-				if (x->parent == nil_)
-					root_ = y;
-				else if (x == x->parent->left) //x is left child
-					x->parent->left = y;
-				else
-					x->parent->right = y; //x is right child
-				y->parent = x->parent;
+				node_pointer new_node = create_new_node_(node->value, node->colour, parent);
+				balance_type::copied(node, new_node, node_access_());
+				return new_node;
 			}
 
-			void balance_erase_(node_pointer node)
+			/*Destroys the tree under @node. Left children are rotated up until the node has none,
+			so no recursion and no extra memory is needed.*/
+			void clear_tree_(node_pointer node)
 			{
-				node_pointer sibling;
-				while(node != root_ && node->colour == BLACK)
+				while (node != nil_)
 				{
-					if (node == node->parent->left)
+					if (node->left != nil_)
 					{
-						sibling = node->parent->right;
-						if (sibling->colour == RED)
-						{
-							sibling->colour = BLACK;
-							node->parent->colour = RED;
-							rotate_left_(node->parent);
-							sibling = node->parent->right;
-						}
-						if (sibling->left->colour == BLACK && sibling->right->colour == BLACK)
-						{
-							sibling->colour = RED;
-							node = node->parent;
-						}
-						else
-						{
-							if (sibling->right->colour == BLACK)
-							{
-								sibling->left->colour = BLACK;
-								sibling->colour = RED;
-								rotate_right_(sibling);
-								sibling = node->parent->right;
-							}
-							sibling->colour = node->parent->colour;
-							node->parent->colour = BLACK;
-							sibling->right->colour = BLACK;
-							rotate_left_(node->parent);
-							node = root_;
-						}
+						node_pointer left = node->left;
+						node->left = left->right;
+						left->right = node;
+						node = left;
 					}
 					else
 					{
-						sibling = node->parent->left;
-						if (sibling->colour == RED)
-						{
-							sibling->colour = BLACK;
-							node->parent->colour = RED;
-							rotate_right_(node->parent);
-							sibling = node->parent->left;
-						}
-						if (sibling->right->colour == BLACK && sibling->right->colour == BLACK)
-						{
-							sibling->colour = RED;
-							node = node->parent;
-						}
-						else
-						{
-							if (sibling->left->colour == BLACK)
-							{
-								sibling->right->colour = BLACK;
-								sibling->colour = RED;
-								rotate_left_(sibling);
-								sibling = node->parent->left;
-							}
-							sibling->colour = node->parent->colour;
-							node->parent->colour = BLACK;
-							sibling->left->colour = BLACK;
-							rotate_right_(node->parent);
-							node = root_;
-						}
+						node_pointer right = node->right;
+						destroy_node_(node);
+						node = right;
 					}
 				}
-				node->colour = BLACK;
+			}
+		
+			void destroy_node_(node_pointer node)
+			{
+				alloc_value_().destroy(&node->value);
+				alloc_node_().deallocate(static_cast<node_type*>(node), 1);
+				node = nil_;
 			}
 
-			void balance_insert_(node_pointer node)
+			template <typename Iterator, typename ForwardIterator, typename OutputIterator>
+			OutputIterator find_batch_(ForwardIterator first, ForwardIterator last, OutputIterator out) const
 			{
-				while(node != root_ && node->parent->colour == RED)
+				ForwardIterator	keys[batch_width];
+				node_pointer	nodes[batch_width];
+				bool			searching[batch_width];
+
+				while (first != last)
 				{
-					if(node->parent->parent->left == node->parent)
+					size_type count = 0;
+					for (; count < batch_width && first != last; ++count, ++first)
 					{
-						node_pointer uncle = node->parent->parent->right;
-						if (uncle != nil_ && uncle->colour == RED)
-						{
-							uncle->colour = BLACK;
-							node->parent->colour = BLACK;
-							node->parent->parent->colour = RED;
-							node = node->parent->parent;
-						}
-						else
-						{
-							if (node == node->parent->right)
-							{
-								node = node->parent;
-								rotate_left_(node);
-							}
-							node->parent->colour = BLACK;
-							node->parent->parent->colour = RED;
-							rotate_right_(node->parent->parent);
-						}
+						keys[count] = first;
+						nodes[count] = root_;
+						searching[count] = root_ != nil_;
 					}
-					else
+					for (size_type active = count; active != 0;)
 					{
-						node_pointer uncle = node->parent->parent->left;
-						if (uncle != mynullptr && uncle->colour == RED)
+						active = 0;
+						for (size_type i = 0; i < count; ++i)
 						{
-							uncle->colour = BLACK;
-							node->parent->colour = BLACK;
-							node->parent->parent->colour = RED;
-							node = node->parent->parent;
-						}
-						else
-						{
-							if (node == node->parent->left)
+							if (!searching[i])
+								continue ;
+							node_pointer node = nodes[i];
+							if (less_(node->value, *keys[i]))
+								node = node->right;
+							else if (less_(*keys[i], node->value))
+								node = node->left;
+							else
+							{
+								searching[i] = false;
+								continue ;
+							}
+							nodes[i] = node;
+							searching[i] = node != nil_;
+							if (searching[i])
 							{
-								node = node->parent;
-								rotate_right_(node);
+								ft::prefetch_(node);
+								++active;
 							}
-							node->parent->colour = BLACK;
-							node->parent->parent->colour = RED;
-							rotate_left_(node->parent->parent);
 						}
 					}
-					root_->colour = BLACK;
+					for (size_type i = 0; i < count; ++i, ++out)
+						*out = Iterator(nodes[i]);
 				}
+				return out;
 			}
 
-			void clear_tree_(node_pointer node)
+			/*Returns the first node whose value is not ordered before @key, or nil*/
+			template <typename Key>
+			node_pointer lower_bound_(const Key& key) const
 			{
-				if (node == nil_ || node == mynullptr || node == node->left || node == node->right)
-					return ;
-				clear_tree_(node->right);
-				clear_tree_(node->left);
-				destroy_node_(node);
+				node_pointer node = root_;
+				node_pointer result = nil_;
+				while (node != nil_)
+				{
+					if (less_(node->value, key))
+						node = node->right;
+					else
+					{
+						result = node;
+						node = node->left;
+					}
+				}
+				return result;
 			}
-		
-			void destroy_node_(node_pointer node)
+
+			/*Returns the first node whose value is ordered after @key, or nil*/
+			template <typename Key>
+			node_pointer upper_bound_(const Key& key) const
 			{
-				alloc_value_.destroy(&node->value);
-				alloc_node_.deallocate(node, 1);
-				node = nil_;
+				node_pointer node = root_;
+				node_pointer result = nil_;
+				while (node != nil_)
+				{
+					if (less_(key, node->value))
+					{
+						result = node;
+						node = node->left;
+					}
+					else
+						node = node->right;
+				}
+				return result;
 			}
 
 		public:
@@ -337,9 +428,9 @@ namespace ft
 			void clear()
 			{
 				clear_tree_(root_);
-				node_count_ = 0;
+				node_count_() = 0;
 				root_ = nil_;
-				left_most_ = root_;
+				left_most_() = root_;
 			}
 
 			iterator	erase(iterator pos)
@@ -348,93 +439,132 @@ namespace ft
 					return end();
 				node_pointer next = rbt_next(pos.base());
 				node_pointer z = pos.base();
-				node_pointer y = z;
+				node_pointer right_most = z == nil_->parent ? rbt_previous(z) : nil_->parent;
+				node_pointer y;
 				node_pointer x;
-				COLOUR original_colour = y->colour;
+				node_pointer x_parent = z->parent;
 
 				if (z->left == nil_)
 				{
 					x = z->right;
-					transplant_(z, x);
+					rbt_transplant(z, x, root_, node_access_());
 				}
 				else if (z->right == nil_)
 				{
 					x = z->left;
-					transplant_(z, x);
+					rbt_transplant(z, x, root_, node_access_());
 				}
 				else
 				{
 					y = rbt_leftmost(z->right);
-					original_colour = y->colour;
 					x = y->right;
 					if (y->parent == z)
-						x->parent = y;
+						x_parent = y;
 					else
 					{
-						transplant_(y, y->right);
+						x_parent = y->parent;
+						rbt_transplant(y, y->right, root_, node_access_());
 						y->right = z->right;
 						y->right->parent = y;
 					}
-					transplant_(z, y);
+					rbt_transplant(z, y, root_, node_access_());
 					y->left = z->left;
 					y->left->parent = y;
-					y->colour = z->colour;
+					Balance::swap_state(y, z, node_access_());
 				}
-				if (z == left_most_)
-					left_most_ = next;
+				if (z == left_most_())
+					left_most_() = next;
+				Balance::erased(z, x, x_parent, root_, counters_(), node_access_());
 				destroy_node_(z);
-				if (original_colour == BLACK)
-					balance_erase_(x);
-				nil_->parent = rbt_rightmost(root_);
-				--node_count_;
+				nil_->parent = right_most;
+				--node_count_();
 				return iterator(next);
 			}
 
-			ft::pair<iterator, bool> insert(const value_type& value)
+			/*Where a lookup ended: the node holding an equivalent value, or nil with the parent and side a new node
+			for the key would be linked to.*/
+			struct insert_position
+			{
+				node_pointer	node;
+				node_pointer	parent;
+				bool			left;
+			};
+
+			/*Descends once for @key and returns the node holding it or the place it belongs*/
+			template <typename Key>
+			insert_position find_position(const Key& key) const
 			{
-				node_pointer parent = root_, new_node;
+				insert_position pos = { root_, nil_, false };
 
-				for(node_pointer iter = root_; iter != nil_;)
+				while (pos.node != nil_)
 				{
-					parent = iter;
-					if (compare_(value, iter->value))
-						iter = iter->left;
-					else if (compare_(iter->value, value))
-						iter = iter->right;
+					pos.parent = pos.node;
+					if (less_(key, pos.node->value))
+					{
+						pos.left = true;
+						pos.node = pos.node->left;
+					}
+					else if (less_(pos.node->value, key))
+					{
+						pos.left = false;
+						pos.node = pos.node->right;
+					}
 					else
-						return ft::make_pair(iterator(iter), false);
+						break ;
 				}
-				if (root_ == nil_)
-					root_ = left_most_ = new_node = create_new_node_(value, BLACK, parent);
+				return pos;
+			}
+
+			/*Links a new node for @value at @pos, which find_position returned for a missing key,
+			and rebalances the tree. No comparisons are made.*/
+			iterator insert_at(const insert_position& pos, const value_type& value)
+			{
+				node_pointer new_node;
+
+				if (pos.parent == nil_)
+					root_ = left_most_() = new_node = create_new_node_(value, BLACK, nil_);
 				else
 				{
-					new_node = create_new_node_(value, RED, parent);
-					if (compare_(value, parent->value))
-						parent->left = new_node;
+					new_node = create_new_node_(value, RED, pos.parent);
+					if (pos.left)
+						pos.parent->left = new_node;
 					else
-						parent->right = new_node; 
+						pos.parent->right = new_node;
 				}
-				if (left_most_->left != nil_)
-					left_most_ = left_most_->left;
-				balance_insert_(new_node);
-				++node_count_;
-				if (new_node == rbt_rightmost(root_))
+				if (left_most_()->left != nil_)
+					left_most_() = left_most_()->left;
+				if (pos.parent == nil_ || (pos.parent == nil_->parent && !pos.left))
 					nil_->parent = new_node;
-				return ft::make_pair(iterator(new_node), true);
+				Balance::inserted(new_node, root_, counters_(), node_access_());
+				++node_count_();
+				return iterator(new_node);
+			}
+
+			ft::pair<iterator, bool> insert(const value_type& value)
+			{
+				insert_position pos = find_position(value);
+
+				if (pos.node != nil_)
+					return ft::make_pair(iterator(pos.node), false);
+				return ft::make_pair(insert_at(pos, value), true);
 			}
 
+			/*A found node is reported to the balancing policy, which may move it, e.g. splay it to the root*/
 			template <typename Key>
 			iterator find (const Key& key)
 			{
 				node_pointer iter = root_;
 				while(iter != nil_)
 				{
-					if (compare_(iter->value, key))
+					if (less_(iter->value, key))
 						iter = iter->right;
-					else if (compare_(key, iter->value))
+					else if (less_(key, iter->value))
 						iter = iter->left;
 					else
+					{
+						Balance::accessed(iter, root_, counters_(), node_access_());
 						return iter;
+					}
 				}
 				return (end());
 			}
@@ -445,9 +575,9 @@ namespace ft
 				node_pointer iter = root_;
 				while(iter != nil_)
 				{
-					if (compare_(iter->value, key))
+					if (less_(iter->value, key))
 						iter = iter->right;
-					else if (compare_(key, iter->value))
+					else if (less_(key, iter->value))
 						iter = iter->left;
 					else
 						return iter;
@@ -455,54 +585,105 @@ namespace ft
 				return (end());
 			}
 
+			/*Stores find(key) for every key of [first, last) to @out and returns the end of the output.
+			Up to batch_width descents advance in lockstep, one level per round, and the next node of each
+			is prefetched, so the cache misses of independent lookups overlap instead of queueing up.*/
+			template <typename ForwardIterator, typename OutputIterator>
+			OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out)
+			{ return find_batch_<iterator>(first, last, out); }
+
+			template <typename ForwardIterator, typename OutputIterator>
+			OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out) const
+			{ return find_batch_<const_iterator>(first, last, out); }
+
+			/*Outcome of a finger search: the node holding the key or nil, the node the search ended at,
+			and whether the search stayed below the root.*/
+			struct finger_result
+			{
+				node_pointer	node;
+				node_pointer	last;
+				bool			local;
+			};
+
+			/*Finger search: looks for @key starting at @finger instead of at the root. It climbs from @finger only
+			until the key lies in the range of the current subtree, then descends again. The cost is about twice the
+			height of the smallest subtree holding both @finger and @key: small on average for a stream of nearby keys,
+			but O(log n) in the worst case, e.g. for neighbours on either side of the root. A null or nil @finger
+			searches from the root.*/
+			template <typename Key>
+			finger_result finger_find(node_pointer finger, const Key& key) const
+			{
+				finger_result result = { nil_, root_, false };
+				node_pointer node = finger;
+
+				if (node == mynullptr || node == nil_)
+					node = root_;
+				else if (less_(key, node->value))
+				{
+					// climb until the parent is a lower bound of the key, the subtree then spans it
+					for (; node->parent != nil_; node = node->parent)
+						if (node == node->parent->right && !less_(key, node->parent->value))
+							break ;
+					result.local = node->parent != nil_;
+				}
+				else if (less_(node->value, key))
+				{
+					for (; node->parent != nil_; node = node->parent)
+						if (node == node->parent->left && !less_(node->parent->value, key))
+							break ;
+					result.local = node->parent != nil_;
+				}
+				else
+				{
+					result.node = result.last = node;
+					result.local = true;
+					return result;
+				}
+				if (result.local && !less_(key, node->parent->value) && !less_(node->parent->value, key))
+				{
+					result.node = result.last = node->parent;
+					return result;
+				}
+				while (node != nil_)
+				{
+					result.last = node;
+					if (less_(node->value, key))
+						node = node->right;
+					else if (less_(key, node->value))
+						node = node->left;
+					else
+					{
+						result.node = node;
+						break ;
+					}
+				}
+				return result;
+			}
+
 			void swap(red_black_tree& other)
 			{
-				ft::swap(compare_, other.compare_);
-				ft::swap(alloc_value_, other.alloc_value_);
-				ft::swap(alloc_node_, other.alloc_node_);
+				ft::swap(compare_count_, other.compare_count_);
+				ft::swap(left_most_(), other.left_most_());
+				swap_allocator_(other, ft::allocator_propagates<allocator_type>());
 				ft::swap(root_, other.root_);
-				ft::swap(left_most_, other.left_most_);
 				ft::swap(nil_, other.nil_);
-				ft::swap(node_count_, other.node_count_);
 			}
 
 			template <typename Key>
 			iterator lower_bound(const Key& key)
-			{
-				iterator it = begin();
-
-				while (compare_(*it, key) && it != end())
-					++it;
-				return iterator(it);	
-			}
+			{ return iterator(lower_bound_(key)); }
 
 			template <typename Key>
 			const_iterator lower_bound(const Key& key) const
-			{
-				const_iterator it = begin();
-
-				while (compare_(*it, key) && it != end())
-					++it;
-				return const_iterator(it);
-			}
+			{ return const_iterator(lower_bound_(key)); }
 
 			template <typename Key>
 			iterator upper_bound(const Key& key)
-			{
-				iterator it = lower_bound(key);
-				if (!compare_(*it, key) && !compare_(key, *it))
-					++it;
-				return it;
-			}
+			{ return iterator(upper_bound_(key)); }
 
 			template <typename Key>
 			const_iterator upper_bound(const Key& key) const
-			{
-				const_iterator it = lower_bound(key);
-				if(!compare_(*it, key) && !compare_(key, *it))
-					++it;
-				return it;
-			}
+			{ return const_iterator(upper_bound_(key)); }
 
 			template <typename Key>
 			ft::pair<iterator,iterator> equal_range(const Key& key)
@@ -529,4 +710,56 @@ namespace ft
 				}
 			}
 	};
+
+	/* Last-access cache for a red_black_tree. Each lookup starts a finger search at the node the previous one
+	ended at, so streams of neighbouring keys are found in a few steps. Counts the lookups that stayed local
+	(hits) and those that had to climb to the root (misses).
+	The finger is a node of the tree: erasing that element invalidates it like an iterator, call reset() then.*/
+	template <typename Tree, typename Iterator>
+	class tree_finger
+	{
+		public:
+			typedef typename Tree::size_type		size_type;
+			typedef Iterator						iterator;
+
+		private:
+			typedef typename Tree::node_pointer		node_pointer;
+
+		public:
+			/*Creates a finger on @tree, empty until the first lookup*/
+			explicit tree_finger(Tree& tree)
+			:tree_(&tree), node_(mynullptr), hits_(0), misses_(0) {}
+
+			/*Finds @key starting from the previous lookup*/
+			template <typename Key>
+			iterator find(const Key& key)
+			{
+				typename Tree::finger_result result = tree_->finger_find(node_, key);
+
+				node_ = result.last;
+				if (result.local)
+					++hits_;
+				else
+					++misses_;
+				return iterator(result.node);
+			}
+
+			/*Forgets the last position, the next lookup starts at the root*/
+			void reset()
+			{ node_ = mynullptr; }
+
+			/*Returns the number of lookups that stayed below the root*/
+			size_type hits() const
+			{ return hits_; }
+
+			/*Returns the number of lookups that climbed to the root or had no finger to start from*/
+			size_type misses() const
+			{ return misses_; }
+
+		private:
+			Tree*			tree_;
+			node_pointer	node_;
+			size_type		hits_;
+			size_type		misses_;
+	};
 }
\ No newline at end of file
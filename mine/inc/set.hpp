@@ -5,7 +5,9 @@
 
 namespace ft
 {
-	template <typename Key, typename Compare = std::less<Key>, typename Allocator = std::allocator< Key > >
+	/* @Balance selects the balancing policy of the underlying tree, see map.*/
+	template <typename Key, typename Compare = std::less<Key>, typename Allocator = std::allocator< Key >,
+	typename Balance = ft::red_black_balance>
 	class set
 	{
 		public:
@@ -22,7 +24,7 @@ namespace ft
 			typedef typename allocator_type::difference_type						difference_type;
 
 		private:
-			typedef ft::red_black_tree<value_type, value_compare, allocator_type>	tree_type;
+			typedef ft::red_black_tree<value_type, value_compare, allocator_type, Balance>	tree_type;
 			typedef typename tree_type::iterator									non_const_iterator;
 
 		public:
@@ -60,6 +62,13 @@ namespace ft
 			tree_type tree_;
 
 		public:
+			/*Last-access cache for lookups in a set, see ft::tree_finger. Each find starts where the previous one
+			ended, which pays off for streams of neighbouring keys. Counts hits and misses.*/
+			class finger : public ft::tree_finger<tree_type, iterator>
+			{
+				public:
+					explicit finger(set& owner) : ft::tree_finger<tree_type, iterator>(owner.tree_) {}
+			};
 
 			/***********************************************
 				ITERATORS
@@ -207,6 +216,17 @@ namespace ft
 			const_iterator find(const key_type& key) const
 			{ return tree_.find(key); }
 
+			/*Writes find(key) for every key in [first, last) to @out. Interleaves the descents of several keys
+			to overlap their cache misses, which is faster than a loop over find for large sets.*/
+			template <class ForwardIterator, class OutputIterator>
+			OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out)
+			{ return tree_.find_batch(first, last, out); }
+
+			/*Writes find(key) for every key in [first, last) to @out as read-only iterators.*/
+			template <class ForwardIterator, class OutputIterator>
+			OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out) const
+			{ return tree_.find_batch(first, last, out); }
+
 			/*Returns a range containing all elements with the given key in the container.*/
 			ft::pair<iterator,iterator> equal_range(const key_type& key )
 			{ return tree_.equal_range(key); }
@@ -227,6 +247,70 @@ namespace ft
     		const_iterator upper_bound(const key_type& key) const 
 			{ return tree_.upper_bound(key); }
 
+			/***********************************************
+				HETEROGENEOUS LOOKUP
+			***********************************************/
+
+			/*The overloads below take any key type @K that key_compare can order against key_type. They only exist
+			if key_compare defines is_transparent, and avoid constructing a temporary key_type per lookup.*/
+
+			/*Returns the number of elements with key equivalent to @key.*/
+			template <typename K>
+			typename ft::enable_if_transparent<key_compare, K, size_type>::type count(const K& key) const
+			{ return tree_.find(key) == end() ? 0 : 1; }
+
+			/*Finds an element with key equivalent to @key.*/
+			template <typename K>
+			typename ft::enable_if_transparent<key_compare, K, iterator>::type find(const K& key)
+			{ return tree_.find(key); }
+
+			/*Finds an element with key equivalent to @key.*/
+			template <typename K>
+			typename ft::enable_if_transparent<key_compare, K, const_iterator>::type find(const K& key) const
+			{ return tree_.find(key); }
+
+			/*Returns a range containing all elements with key equivalent to @key.*/
+			template <typename K>
+			typename ft::enable_if_transparent<key_compare, K, ft::pair<iterator, iterator> >::type
+			equal_range(const K& key)
+			{ return tree_.equal_range(key); }
+
+			/*Returns a range containing all elements with key equivalent to @key.*/
+			template <typename K>
+			typename ft::enable_if_transparent<key_compare, K, ft::pair<const_iterator, const_iterator> >::type
+			equal_range(const K& key) const
+			{ return tree_.equal_range(key); }
+
+			/*Returns an iterator to the first element whose key is not less than @key.*/
+			template <typename K>
+			typename ft::enable_if_transparent<key_compare, K, iterator>::type lower_bound(const K& key)
+			{ return tree_.lower_bound(key); }
+
+			template <typename K>
+			typename ft::enable_if_transparent<key_compare, K, const_iterator>::type lower_bound(const K& key) const
+			{ return tree_.lower_bound(key); }
+
+			/*Returns an iterator to the first element whose key is greater than @key.*/
+			template <typename K>
+			typename ft::enable_if_transparent<key_compare, K, iterator>::type upper_bound(const K& key)
+			{ return tree_.upper_bound(key); }
+
+			template <typename K>
+			typename ft::enable_if_transparent<key_compare, K, const_iterator>::type upper_bound(const K& key) const
+			{ return tree_.upper_bound(key); }
+
+			/*Removes the element with key equivalent to @key.*/
+			template <typename K>
+			typename ft::enable_if_transparent<key_compare, K, size_type>::type erase(const K& key)
+			{
+				non_const_iterator node = tree_.find(key);
+
+				if (node == end())
+					return 0;
+				tree_.erase(node);
+				return 1;
+			}
+
 			/***********************************************
 				OBSERVERS
 			***********************************************/
@@ -241,55 +325,66 @@ namespace ft
 			allocator_type get_allocator() const
 			{ return tree_.get_allocator(); }
 
+			/*Returns the comparisons, rotations and rebalancing steps counted since the set was made or
+			reset_stats() was last called, and its current height and black height. The counters are
+			only collected if FT_TREE_STATS is defined; without it they are zero and cost nothing.
+			A stats build is single-threaded only: its lookups update the counters, even on a const set.*/
+			ft::tree_stats stats() const
+			{ return tree_.stats(); }
+
+			/*Sets the counters reported by stats() back to zero*/
+			void reset_stats()
+			{ tree_.reset_stats(); }
+
 			void print_tree()
 			{ tree_.print_from_node_(tree_.root_node());};
 
 	};
 
-	template <typename Key, typename Compare, typename Allocator>
-	inline bool operator==(const set<Key, Compare, Allocator>& lhs,
-							const set<Key, Compare, Allocator>& rhs)
+	template <typename Key, typename Compare, typename Allocator, typename Balance>
+	inline bool operator==(const set<Key, Compare, Allocator, Balance>& lhs,
+							const set<Key, Compare, Allocator, Balance>& rhs)
 	{
 		return (lhs.size() == rhs.size()) && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
 	}
 
-	template <typename Key, typename Compare, typename Allocator>
-	inline bool operator!=(const set<Key, Compare, Allocator>& lhs,
-						const set<Key, Compare, Allocator>& rhs)
+	template <typename Key, typename Compare, typename Allocator, typename Balance>
+	inline bool operator!=(const set<Key, Compare, Allocator, Balance>& lhs,
+						const set<Key, Compare, Allocator, Balance>& rhs)
 	{
 		return !(lhs == rhs);
 	}
 
-	template <typename Key, typename Compare, typename Allocator>
-	inline bool operator<(const set<Key, Compare, Allocator>& lhs,
-						const set<Key, Compare, Allocator>& rhs)
+	template <typename Key, typename Compare, typename Allocator, typename Balance>
+	inline bool operator<(const set<Key, Compare, Allocator, Balance>& lhs,
+						const set<Key, Compare, Allocator, Balance>& rhs)
 	{
 		return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 	}
 
-	template <typename Key, typename Compare, typename Allocator>
-	inline bool operator<=(const set<Key,  Compare, Allocator>& lhs,
-						const set<Key, Compare, Allocator>& rhs)
+	template <typename Key, typename Compare, typename Allocator, typename Balance>
+	inline bool operator<=(const set<Key,  Compare, Allocator, Balance>& lhs,
+						const set<Key, Compare, Allocator, Balance>& rhs)
 	{
 		return !(rhs < lhs);
 	}
 
-	template <typename Key, typename Compare, typename Allocator>
-	inline bool operator>(const set<Key, Compare, Allocator>& lhs,
-						const set<Key, Compare, Allocator>& rhs)
+	template <typename Key, typename Compare, typename Allocator, typename Balance>
+	inline bool operator>(const set<Key, Compare, Allocator, Balance>& lhs,
+						const set<Key, Compare, Allocator, Balance>& rhs)
 	{
 		return rhs < lhs;
 	}
 
-	template <typename Key, typename Compare, typename Allocator>
-	inline bool operator>=(const set<Key, Compare, Allocator>& lhs,
-						const set<Key, Compare, Allocator>& rhs)
+	template <typename Key, typename Compare, typename Allocator, typename Balance>
+	inline bool operator>=(const set<Key, Compare, Allocator, Balance>& lhs,
+						const set<Key, Compare, Allocator, Balance>& rhs)
 	{
 		return !(lhs < rhs);
 	}
 
-	template <typename Key, typename T, typename Compare, typename Allocator>
-	inline void swap(set<Key, Compare, Allocator>& x, set<Key, Compare, Allocator>& y)
+	template <typename Key, typename T, typename Compare, typename Allocator, typename Balance>
+	inline void swap(set<Key, Compare, Allocator, Balance>& x, set<Key, Compare, Allocator, Balance>& y)
 	{
 		x.swap(y);
 	}
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "mynullptr.hpp"
+#include "iterator.hpp"
+#include "vector.hpp"
+#include "type_traits.hpp"
+#include <cstddef>
+
+namespace ft
+{
+	/* ft::span is a non-owning view over a contiguous sequence of objects.
+	It stores a pointer and a length only, so slices can be passed around without copies or allocation.*/
+	template <typename T>
+	class span
+	{
+		public:
+			typedef T											element_type;
+			typedef typename ft::remove_cv<T>::type				value_type;
+			typedef T*											pointer;
+			typedef const T*									const_pointer;
+			typedef T&											reference;
+			typedef const T&									const_reference;
+			typedef std::size_t									size_type;
+			typedef std::ptrdiff_t								difference_type;
+			typedef ft::normal_iterator<pointer, span>			iterator;
+			typedef ft::normal_iterator<const_pointer, span>	const_iterator;
+			typedef ft::reverse_iterator<iterator>				reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+
+			/*Passed as @count to subspan to select everything up to the end of the span*/
+			static const size_type npos = static_cast<size_type>(-1);
+
+		public:
+			/***********************************************
+				Constructors
+			***********************************************/
+
+			/*Default constructor creates an empty span*/
+			span()
+			:data_(mynullptr), size_(0)
+			{ }
+
+			/*Constructor viewing the @count objects starting at @first. Any integral @count is taken,
+			so that a literal 0 selects this constructor and not the one taking two pointers.*/
+			template <typename Count>
+			span(pointer first, Count count, typename ft::enable_if<ft::is_integral<Count>::value>::type* = 0)
+			:data_(first), size_(static_cast<size_type>(count))
+			{ }
+
+			/*Constructor viewing the range [@first, @last)*/
+			span(pointer first, pointer last)
+			:data_(first), size_(static_cast<size_type>(last - first))
+			{ }
+
+			/*Constructor viewing all elements of the array @arr*/
+			template <std::size_t N>
+			span(element_type (&arr)[N])
+			:data_(arr), size_(N)
+			{ }
+
+			/*Constructor viewing all elements of @vec*/
+			template <typename U, typename Alloc>
+			span(ft::vector<U, Alloc>& vec)
+			:data_(vec.data()), size_(vec.size())
+			{ }
+
+			/*Constructor viewing all elements of the read-only @vec. Only available for spans over const elements*/
+			template <typename U, typename Alloc>
+			span(const ft::vector<U, Alloc>& vec)
+			:data_(vec.data()), size_(vec.size())
+			{ }
+
+			/*Converting constructor. Allows span<T> to span<const T> conversion, only taken if U* converts to T*/
+			template <typename U>
+			span(const span<U>& other, typename ft::enable_if<ft::is_convertible<U*, T*>::value>::type* = 0)
+			:data_(other.data()), size_(other.size())
+			{ }
+
+			/***********************************************
+				DESTRUCTORS
+			***********************************************/
+
+			/*Destructs the span. The viewed elements are left untouched*/
+			~span() {}
+
+			/***********************************************
+				ELEMENT ACCESS
+			***********************************************/
+
+			/*Returns a reference to the element at @pos. Out_of_range lookups are not defined.*/
+			reference operator[](size_type pos) const
+			{ return data_[pos];}
+
+			/*Returns a reference to the first element of the span*/
+			reference front() const
+			{ return *data_;}
+
+			/*Returns a reference to the last element of the span*/
+			reference back() const
+			{ return data_[size_ - 1];}
+
+			/*Returns a pointer to the beginning of the viewed sequence*/
+			pointer data() const
+			{ return data_;}
+
+			/***********************************************
+				ITERATORS
+			***********************************************/
+
+			/*Returns an iterator to the first element of the span. */
+			iterator begin() const { return iterator(data_);}
+
+			/*Returns an iterator to the element following the last element of the span.*/
+			iterator end() const { return iterator(data_ + size_);}
+
+			/*Returns a reverse iterator to the first element of the reversed span.*/
+			reverse_iterator rbegin() const { return reverse_iterator(end());}
+
+			/*Returns a reverse iterator to the element following the last element of the reversed span.*/
+			reverse_iterator rend() const { return reverse_iterator(begin());}
+
+			/*Returns a read-only iterator to the first element of the span. */
+			const_iterator cbegin() const { return const_iterator(data_);}
+
+			/*Returns a read-only iterator to the element following the last element of the span.*/
+			const_iterator cend() const { return const_iterator(data_ + size_);}
+
+			/***********************************************
+				OBSERVERS
+			***********************************************/
+
+			/*Returns the number of elements in the span*/
+			size_type size() const
+			{ return size_;}
+
+			/*Returns the size of the viewed sequence in bytes*/
+			size_type size_bytes() const
+			{ return size_ * sizeof(element_type);}
+
+			/*Checks if the span is empty*/
+			bool empty() const
+			{ return size_ == 0;}
+
+			/***********************************************
+				SUBVIEWS
+			***********************************************/
+
+			/*Returns a span over the first @count elements*/
+			span first(size_type count) const
+			{ return span(data_, count);}
+
+			/*Returns a span over the last @count elements*/
+			span last(size_type count) const
+			{ return span(data_ + (size_ - count), count);}
+
+			/*Returns a span over the @count elements starting at @offset, or up to the end if @count is npos*/
+			span subspan(size_type offset, size_type count = npos) const
+			{ return span(data_ + offset, count == npos ? size_ - offset : count);}
+
+		private:
+			pointer		data_;
+			size_type	size_;
+	};
+
+	/***********************************************
+		NON-MEMBER FUNCTIONS
+	***********************************************/
+
+	/*Creates a span over the @count objects starting at @first*/
+	template <typename T>
+	inline span<T> make_span(T* first, std::size_t count)
+	{ return span<T>(first, count);}
+
+	/*Creates a span over all elements of @vec*/
+	template <typename T, typename Alloc>
+	inline span<T> make_span(ft::vector<T, Alloc>& vec)
+	{ return span<T>(vec);}
+
+	/*Creates a read-only span over all elements of @vec*/
+	template <typename T, typename Alloc>
+	inline span<const T> make_span(const ft::vector<T, Alloc>& vec)
+	{ return span<const T>(vec);}
+}
@@ -0,0 +1,335 @@
+#pragma once
+
+#include "vector.hpp"
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace ft
+{
+	/* ft::thread_pool runs small tasks on a fixed set of POSIX threads.
+	Every worker owns a task queue. Workers pop their own newest task first and steal the oldest task
+	of another worker when their queue runs dry. Code using it must be compiled and linked with -pthread.*/
+	class thread_pool
+	{
+		public:
+			typedef std::size_t		size_type;
+			typedef void			(*task_function)(void*);
+
+		private:
+			struct task
+			{
+				task_function	function;
+				void*			argument;
+			};
+
+			/*Mutex protected double ended task queue. The owner works at the back, thieves take from the front.*/
+			class task_queue
+			{
+				public:
+					task_queue(): head_(0) { pthread_mutex_init(&mutex_, 0); }
+
+					~task_queue() { pthread_mutex_destroy(&mutex_); }
+
+					void push(const task& t)
+					{
+						pthread_mutex_lock(&mutex_);
+						tasks_.push_back(t);
+						pthread_mutex_unlock(&mutex_);
+					}
+
+					bool pop_back(task& t)
+					{
+						pthread_mutex_lock(&mutex_);
+						const bool found = head_ != tasks_.size();
+						if (found)
+						{
+							t = tasks_.back();
+							tasks_.pop_back();
+							compact_();
+						}
+						pthread_mutex_unlock(&mutex_);
+						return found;
+					}
+
+					bool steal_front(task& t)
+					{
+						pthread_mutex_lock(&mutex_);
+						const bool found = head_ != tasks_.size();
+						if (found)
+						{
+							t = tasks_[head_++];
+							compact_();
+						}
+						pthread_mutex_unlock(&mutex_);
+						return found;
+					}
+
+				private:
+					task_queue(const task_queue&);
+					task_queue& operator=(const task_queue&);
+
+					/*Drops the stolen slots once the queue has been drained*/
+					void compact_()
+					{
+						if (head_ == tasks_.size())
+						{
+							tasks_.clear();
+							head_ = 0;
+						}
+					}
+
+					pthread_mutex_t		mutex_;
+					ft::vector<task>	tasks_;
+					size_type			head_;
+			};
+
+			/*Start arguments of a worker thread*/
+			struct worker
+			{
+				thread_pool*	pool;
+				size_type		index;
+				pthread_t		thread;
+			};
+
+		public:
+			/***********************************************
+				Constructors
+			***********************************************/
+
+			/*Starts @threads workers. Zero selects the number of online processors.*/
+			explicit thread_pool(size_type threads = 0)
+			:queues_(), workers_(), pending_(0), next_queue_(0), stop_(false)
+			{
+				if (threads == 0)
+					threads = hardware_concurrency();
+				pthread_mutex_init(&sleep_mutex_, 0);
+				pthread_cond_init(&wake_up_, 0);
+				pthread_key_create(&worker_key_, 0);
+				queues_.reserve(threads);
+				for (size_type i = 0; i < threads; ++i)
+					queues_.push_back(new task_queue());
+				workers_.resize(threads);
+				for (size_type i = 0; i < threads; ++i)
+				{
+					workers_[i].pool = this;
+					workers_[i].index = i;
+					if (pthread_create(&workers_[i].thread, 0, &thread_pool::worker_main_, &workers_[i]) != 0)
+					{
+						workers_.resize(i);
+						shutdown_();
+						throw std::runtime_error("thread_pool");
+					}
+				}
+			}
+
+			/***********************************************
+				DESTRUCTORS
+			***********************************************/
+
+			/*Finishes the queued tasks, then joins the workers.*/
+			~thread_pool()
+			{ shutdown_(); }
+
+			/***********************************************
+				GLOBAL POOL
+			***********************************************/
+
+			/*Returns the process wide pool with one worker per online processor. It lives until the process exits.*/
+			static thread_pool& instance()
+			{
+				static pthread_once_t	once = PTHREAD_ONCE_INIT;
+				pthread_once(&once, &thread_pool::create_instance_);
+				return *instance_slot_();
+			}
+
+			/*Returns the number of online processors, at least 1*/
+			static size_type hardware_concurrency()
+			{
+				const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+				return cpus > 0 ? static_cast<size_type>(cpus) : 1;
+			}
+
+			/***********************************************
+				CAPACITY
+			***********************************************/
+
+			/*Returns the number of worker threads*/
+			size_type size() const
+			{ return workers_.size(); }
+
+			/***********************************************
+				MODIFIERS
+			***********************************************/
+
+			/*Queues @function(@argument). Called from a worker the task goes to its own queue,
+			otherwise the queues are filled round robin. @function must not throw: an exception leaving a task
+			ends the process through std::terminate. Tasks run through a task_group report theirs instead.*/
+			void submit(task_function function, void* argument)
+			{
+				task t;
+				t.function = function;
+				t.argument = argument;
+				const worker* self = static_cast<const worker*>(pthread_getspecific(worker_key_));
+				const size_type queue = self != 0 ? self->index
+					: __sync_fetch_and_add(&next_queue_, 1) % queues_.size();
+				queues_[queue]->push(t);
+				__sync_fetch_and_add(&pending_, 1);
+				pthread_mutex_lock(&sleep_mutex_);
+				pthread_cond_signal(&wake_up_);
+				pthread_mutex_unlock(&sleep_mutex_);
+			}
+
+			/*Runs one queued task on the calling thread. Returns false if no task was found.
+			Threads that wait for tasks they submitted call this to help instead of blocking.*/
+			bool run_pending_task()
+			{
+				const worker* self = static_cast<const worker*>(pthread_getspecific(worker_key_));
+				task t;
+				if (!take_task_(self != 0 ? self->index : 0, t))
+					return false;
+				t.function(t.argument);
+				return true;
+			}
+
+		private:
+			thread_pool(const thread_pool&);
+			thread_pool& operator=(const thread_pool&);
+
+			/*Pops from the queue at @home, then tries to steal from every other queue*/
+			bool take_task_(size_type home, task& t)
+			{
+				bool found = queues_[home]->pop_back(t);
+				for (size_type i = 1; !found && i < queues_.size(); ++i)
+					found = queues_[(home + i) % queues_.size()]->steal_front(t);
+				if (found)
+					__sync_fetch_and_sub(&pending_, 1);
+				return found;
+			}
+
+			/*Work loop of a worker thread: run tasks until the pool is stopped and drained, sleep while idle*/
+			static void* worker_main_(void* argument)
+			{
+				worker* self = static_cast<worker*>(argument);
+				thread_pool& pool = *self->pool;
+				pthread_setspecific(pool.worker_key_, self);
+				task t;
+				while (true)
+				{
+					if (pool.take_task_(self->index, t))
+					{
+						t.function(t.argument);
+						continue ;
+					}
+					pthread_mutex_lock(&pool.sleep_mutex_);
+					while (__sync_fetch_and_add(&pool.pending_, 0) <= 0 && !pool.stop_)
+						pthread_cond_wait(&pool.wake_up_, &pool.sleep_mutex_);
+					const bool done = pool.stop_ && __sync_fetch_and_add(&pool.pending_, 0) <= 0;
+					pthread_mutex_unlock(&pool.sleep_mutex_);
+					if (done)
+						return 0;
+				}
+			}
+
+			/*Stops and joins the workers and frees the queues*/
+			void shutdown_()
+			{
+				pthread_mutex_lock(&sleep_mutex_);
+				stop_ = true;
+				pthread_cond_broadcast(&wake_up_);
+				pthread_mutex_unlock(&sleep_mutex_);
+				for (size_type i = 0; i < workers_.size(); ++i)
+					pthread_join(workers_[i].thread, 0);
+				for (size_type i = 0; i < queues_.size(); ++i)
+					delete queues_[i];
+				queues_.clear();
+				workers_.clear();
+				pthread_key_delete(worker_key_);
+				pthread_cond_destroy(&wake_up_);
+				pthread_mutex_destroy(&sleep_mutex_);
+			}
+
+			static thread_pool*& instance_slot_()
+			{
+				static thread_pool* pool = 0;
+				return pool;
+			}
+
+			static void create_instance_()
+			{ instance_slot_() = new thread_pool(); }
+
+		private:
+			ft::vector<task_queue*>	queues_;
+			ft::vector<worker>		workers_;
+			pthread_mutex_t			sleep_mutex_;
+			pthread_cond_t			wake_up_;
+			pthread_key_t			worker_key_;
+			volatile long			pending_;
+			volatile size_type		next_queue_;
+			bool					stop_;
+	};
+
+	/* Thrown by task_group::wait() when a task of the group failed. C++98 cannot carry the original exception
+	across threads, so its what() message is passed on.*/
+	class task_error : public std::runtime_error
+	{
+		public:
+			explicit task_error(const std::string& what): std::runtime_error(what) {}
+	};
+
+	/* Counts the outstanding tasks of one fork-join step. The waiting thread executes queued tasks meanwhile,
+	so nested parallel calls from inside a task cannot deadlock the pool.*/
+	class task_group
+	{
+		public:
+			explicit task_group(thread_pool& pool)
+			:pool_(pool), outstanding_(0), failed_(0)
+			{ }
+
+			/*Queues @function(@argument) as part of this group*/
+			void run(thread_pool::task_function function, void* argument)
+			{
+				__sync_fetch_and_add(&outstanding_, 1);
+				pool_.submit(function, argument);
+			}
+
+			/*Marks one task of the group as finished. Called by the task itself as its last action.*/
+			void done()
+			{ __sync_fetch_and_sub(&outstanding_, 1); }
+
+			/*Records that a task of the group threw. The first message is kept for wait().*/
+			void fail(const char* what)
+			{
+				if (__sync_bool_compare_and_swap(&failed_, 0, 1))
+					message_ = what;
+			}
+
+			/*Returns once every task of the group has called done()*/
+			void join()
+			{
+				while (__sync_fetch_and_add(&outstanding_, 0) != 0)
+					if (!pool_.run_pending_task())
+						sched_yield();
+			}
+
+			/*Joins the group, then throws task_error if one of its tasks failed*/
+			void wait()
+			{
+				join();
+				if (__sync_fetch_and_add(&failed_, 0) != 0)
+					throw task_error(message_);
+			}
+
+		private:
+			task_group(const task_group&);
+			task_group& operator=(const task_group&);
+
+			thread_pool&				pool_;
+			volatile std::size_t		outstanding_;
+			volatile int				failed_;
+			std::string					message_;
+	};
+}
@@ -18,6 +18,13 @@ namespace ft
 		typedef false_type type;
 	};
 
+	/*Maps a compile-time boolean onto true_type/false_type so it can drive tag dispatch*/
+	template <bool B>
+	struct bool_constant : public false_type {};
+
+	template <>
+	struct bool_constant<true> : public true_type {};
+
 	/***********************************************
 		ENABLE IF
 	***********************************************/
@@ -96,6 +103,130 @@ namespace ft
 	template <typename T>
 	struct is_integral : is_integral_spec <typename remove_cv<T>::type> {};
 
+	/* Unsigned integer type of the same width as the integral type @T. Only defined for the types is_integral
+	accepts, so a wider type fails to compile instead of being truncated.*/
+	template <typename T>
+	struct make_unsigned_spec {};
+
+	template<>
+	struct make_unsigned_spec <bool> { typedef unsigned char type; };
+
+	template<>
+	struct make_unsigned_spec <signed char> { typedef unsigned char type; };
+
+	template<>
+	struct make_unsigned_spec <unsigned char> { typedef unsigned char type; };
+
+	template<>
+	struct make_unsigned_spec <char> { typedef unsigned char type; };
+
+	template<>
+	struct make_unsigned_spec <short int> { typedef unsigned short int type; };
+
+	template<>
+	struct make_unsigned_spec <unsigned short int> { typedef unsigned short int type; };
+
+	template<>
+	struct make_unsigned_spec <int> { typedef unsigned int type; };
+
+	template<>
+	struct make_unsigned_spec <unsigned int> { typedef unsigned int type; };
+
+	template<>
+	struct make_unsigned_spec <long int> { typedef unsigned long int type; };
+
+	template<>
+	struct make_unsigned_spec <unsigned long int> { typedef unsigned long int type; };
+
+	template <typename T>
+	struct make_unsigned : make_unsigned_spec <typename remove_cv<T>::type> {};
+
+	/***********************************************
+		FLOATING POINT TYPES
+	***********************************************/
+
+	/* Base template for floating point type checking*/
+	template <typename T>
+	struct is_floating_point_spec : public false_type {};
+
+	/* Specialisation templates for floating point type checking*/
+	template<>
+	struct is_floating_point_spec <float>: public true_type {};
+
+	template<>
+	struct is_floating_point_spec <double>: public true_type {};
+
+	template<>
+	struct is_floating_point_spec <long double>: public true_type {};
+
+	template <typename T>
+	struct is_floating_point : is_floating_point_spec <typename remove_cv<T>::type> {};
+
+	/* Integral or floating point types*/
+	template <typename T>
+	struct is_arithmetic : bool_constant<is_integral<T>::value || is_floating_point<T>::value> {};
+
+	/***********************************************
+		POD TYPES
+	***********************************************/
+
+	/* Types that need no constructor call and can be copied bytewise. Relies on the compiler intrinsic.*/
+	template <typename T>
+	struct is_pod : public bool_constant<__is_pod(T)> {};
+
+	/* Class types without non-static data members, such as stateless comparators and allocators.
+	Relies on the compiler intrinsic.*/
+	template <typename T>
+	struct is_empty : public bool_constant<__is_empty(T)> {};
+
+	/***********************************************
+		ALLOCATOR TRAITS
+	***********************************************/
+
+	/* Allocators that can grow a block while keeping its contents provide reallocate(p, old_n, new_n)
+	and specialize this to true_type.*/
+	template <typename Alloc>
+	struct has_reallocate : public false_type {};
+
+	/* Allocators that can hand out zero filled storage cheaply, e.g. fresh anonymous pages,
+	provide allocate_zeroed(n) and specialize this to true_type.*/
+	template <typename Alloc>
+	struct has_allocate_zeroed : public false_type {};
+
+	/* Whether a container hands its allocator on together with its elements, on copy assignment and swap.
+	C++98 allocators are interchangeable, so by default they do. Allocators tied to a memory source that must
+	get back what it gave specialize this to false_type: they then stay with the container that made them.*/
+	template <typename Alloc>
+	struct allocator_propagates : public true_type {};
+
+	/***********************************************
+		COMPARATOR TRAITS
+	***********************************************/
+
+	/* Detects the is_transparent member type, by which a comparator declares that it orders keys of
+	other types than key_type as well, without converting them.*/
+	template <typename Compare>
+	struct has_is_transparent_
+	{
+		typedef char	yes;
+		typedef char	(&no)[2];
+
+		template <typename C>
+		static yes test(typename C::is_transparent*);
+
+		template <typename C>
+		static no test(...);
+	};
+
+	template <typename Compare>
+	struct has_is_transparent
+	: public bool_constant<sizeof(has_is_transparent_<Compare>::template test<Compare>(0)) == 1> {};
+
+	/* Return type @R of a heterogeneous lookup with a key of type @K. Only defined for transparent comparators;
+	taking @K keeps the condition dependent, so the overload drops out by SFINAE otherwise.*/
+	template <typename Compare, typename K, typename R>
+	struct enable_if_transparent : public enable_if<has_is_transparent<Compare>::value, R> {};
+
 	/***********************************************
 		COMPARISON OF VALUE TYPES
 	***********************************************/
@@ -105,4 +236,27 @@ namespace ft
 
 	template<typename Tp>
 	struct are_same<Tp, Tp>:public true_type {};
+
+	/***********************************************
+		CONVERSIONS
+	***********************************************/
+
+	/* Detects whether @From converts implicitly to @To, by overload resolution between a @To parameter
+	and an ellipsis*/
+	template <typename From, typename To>
+	struct is_convertible_
+	{
+		typedef char	yes;
+		typedef char	(&no)[2];
+
+		static yes test(To);
+
+		static no test(...);
+
+		static From make();
+	};
+
+	template <typename From, typename To>
+	struct is_convertible
+	: public bool_constant<sizeof(is_convertible_<From, To>::test(is_convertible_<From, To>::make())) == 1> {};
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "type_traits.hpp"
+
 namespace ft
 {
 	/* ft::pair is a class template that provides a way to store two heterogeneous objects as a single unit.*/
@@ -45,10 +47,103 @@ namespace ft
 		}
 	};
 	
+	/***********************************************
+		COMPRESSED PAIR
+	***********************************************/
+
+	/*Holds one object of type @T. Empty classes are held as a base class, so they take no space (empty base
+	optimization). @Index tells the two slots of a compressed_pair apart when both have the same type.*/
+	template <typename T, int Index, bool = ft::is_empty<T>::value>
+	class compressed_slot_
+	{
+		public:
+			compressed_slot_(): value_() {}
+
+			compressed_slot_(const T& value): value_(value) {}
+
+			T& get() { return value_; }
+
+			const T& get() const { return value_; }
+
+		private:
+			T	value_;
+	};
+
+	template <typename T, int Index>
+	class compressed_slot_<T, Index, true> : private T
+	{
+		public:
+			compressed_slot_(): T() {}
+
+			compressed_slot_(const T& value): T(value) {}
+
+			T& get() { return *this; }
+
+			const T& get() const { return *this; }
+	};
+
+	/* ft::compressed_pair stores two objects like ft::pair, but an empty class among them adds nothing
+	to its size. Containers keep their comparator and allocator next to a data member in one.*/
+	template <typename T1, typename T2>
+	class compressed_pair : private compressed_slot_<T1, 0>, private compressed_slot_<T2, 1>
+	{
+		private:
+			typedef compressed_slot_<T1, 0>		first_base_;
+			typedef compressed_slot_<T2, 1>		second_base_;
+
+		public:
+			typedef T1			first_type;
+			typedef T2			second_type;
+
+			/*Default constructor. Value-initializes both elements*/
+			compressed_pair(): first_base_(), second_base_() {}
+
+			/*Constructor that initializes the first element with @x and the second with @y*/
+			compressed_pair(const T1& x, const T2& y): first_base_(x), second_base_(y) {}
+
+			first_type& first() { return first_base_::get(); }
+
+			const first_type& first() const { return first_base_::get(); }
+
+			second_type& second() { return second_base_::get(); }
+
+			const second_type& second() const { return second_base_::get(); }
+	};
+
 	/***********************************************
 		NON-MEMBER FUNCTIONS
 	***********************************************/
 
+	/*Function object returning its argument unchanged*/
+	template <typename T>
+	struct identity
+	{
+		typedef T		argument_type;
+		typedef T		result_type;
+
+		const T& operator()(const T& x) const { return x; }
+	};
+
+	/*Function object returning the first member of a pair*/
+	template <typename Pair>
+	struct select1st
+	{
+		typedef Pair							argument_type;
+		typedef typename Pair::first_type		result_type;
+
+		const result_type& operator()(const Pair& x) const { return x.first; }
+	};
+
+	/*Function object ordering its arguments with operator<, whatever their types.
+	Used as the comparator of a map or set it enables lookups with keys of other types than key_type.*/
+	struct transparent_less
+	{
+		typedef void	is_transparent;
+
+		template <typename T, typename U>
+		bool operator()(const T& lhs, const U& rhs) const { return lhs < rhs; }
+	};
+
 	/*Creates a pair object of type, defined by the argument types */
 	template <typename T1, typename T2>
 	pair<T1, T2> make_pair(T1 t, T2 u)
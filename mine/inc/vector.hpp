@@ -3,8 +3,11 @@
 #include "mynullptr.hpp"
 #include "iterator.hpp"
 #include "algorithm.hpp"
+#include "utility.hpp"
 #include <memory>
 #include <exception>
+#include <stdexcept>
+#include <limits>
 
 namespace ft
 {
@@ -36,7 +39,7 @@ namespace ft
 
 			/*Default constructor creates no elements*/
 			explicit vector(const allocator_type& alloc = allocator_type())
-			:alloc_(alloc), start_(mynullptr), finish_(mynullptr), finish_of_storage_(mynullptr)
+			:start_(mynullptr), finish_(mynullptr), storage_(mynullptr, alloc)
 			{ }
 
 			/*Constructors that fills the vector with @n copies of @value*/
@@ -44,13 +47,11 @@ namespace ft
 				size_type n, 
 				const value_type& value = value_type(), 
 				const allocator_type& alloc = allocator_type())
-			:alloc_(alloc), start_(mynullptr), finish_(mynullptr), finish_of_storage_(mynullptr)
+			:start_(mynullptr), finish_(mynullptr), storage_(mynullptr, alloc)
 			{
 				if (n > 0)
-				{
-					allocate_(n);
-					construct_(n, value);
-				}
+					fill_initialize_(n, value, ft::bool_constant<
+						ft::is_pod<value_type>::value && ft::has_allocate_zeroed<allocator_type>::value>());
 			}
 
 			/*constructor builds vector consisting of copies of the elements from [@first, last) */
@@ -59,12 +60,12 @@ namespace ft
 				InputIterator first, 
 				typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type last, 
 				const allocator_type& alloc = allocator_type())
-			:alloc_(alloc), start_(mynullptr), finish_(mynullptr), finish_of_storage_(mynullptr)
+			:start_(mynullptr), finish_(mynullptr), storage_(mynullptr, alloc)
 			{ assign(first, last);}
 
 			/*Copy constructor. Constructs the container with the copy of the contents of @other*/
 			vector(const vector& other)
-			:alloc_(other.get_allocator()), start_(mynullptr), finish_(mynullptr), finish_of_storage_(mynullptr)
+			:start_(mynullptr), finish_(mynullptr), storage_(mynullptr, other.get_allocator())
 			{
 				allocate_(other.size());
 				construct_(other.start_, other.finish_, ft::iterator_category(other.start_));
@@ -94,7 +95,7 @@ namespace ft
 				}
 				else
 				{
-					vector tmp(n, value);
+					vector tmp(n, value, alloc_());
 					(*this).swap(tmp);
 				}
 			}
@@ -106,14 +107,14 @@ namespace ft
 
 			/*Returns the allocator associated with the container. */
 			allocator_type get_allocator() const
-			{ return alloc_;}
+			{ return alloc_();}
 
 			/*Copy assignment operator. Replaces the contents with a copy of the contents of other.*/
 			vector& operator=(const vector& other)
 			{
-				if (*this != other)
+				if (this != &other)
 				{
-					alloc_ = other.get_allocator();
+					copy_allocator_(other.alloc_(), ft::allocator_propagates<allocator_type>());
 					assign(other.begin(), other.end());
 				}
 				return *this;
@@ -213,7 +214,7 @@ namespace ft
 
 			/*Returns the maximum number of elements the container is able to hold due to system or library limitations*/
 			size_type max_size() const
-			{return ft::min<size_type>(alloc_.max_size(), std::numeric_limits<difference_type>::max());}
+			{return ft::min<size_type>(alloc_().max_size(), std::numeric_limits<difference_type>::max());}
 
 			/*Increase the capacity of the vector. 
 			If @new_cap is greater than the current capacity, new storage is allocated, otherwise the function does nothing*/
@@ -222,17 +223,28 @@ namespace ft
 				if (new_cap > max_size())
 					throw std::length_error("vector");
 				if (new_cap > capacity())
-				{
-					vector new_vect(alloc_);
-					new_vect.allocate_(get_new_size_(new_cap));
-					new_vect.construct_(start_, finish_, ft::iterator_category(finish_));
-					swap(new_vect);
-				}
+					reallocate_(get_new_size_(new_cap), ft::bool_constant<
+						ft::is_pod<value_type>::value && ft::has_reallocate<allocator_type>::value>());
 			}
 
 			/*Returns the number of elements that the container has currently allocated space for. */
 			size_type capacity() const
-			{return size_type(finish_of_storage_ - start_);}
+			{return size_type(finish_of_storage_() - start_);}
+
+			/*Releases unused capacity. Storage is reallocated to hold exactly size() elements, an empty vector frees it entirely.*/
+			void shrink_to_fit()
+			{
+				if (finish_ != finish_of_storage_())
+				{
+					vector new_vect(alloc_());
+					if (!empty())
+					{
+						new_vect.allocate_(size());
+						new_vect.construct_(start_, finish_, ft::iterator_category(finish_));
+					}
+					swap(new_vect);
+				}
+			}
 
 			/***********************************************
 				MODIFIERS
@@ -253,16 +265,7 @@ namespace ft
 
 			/*Inserts elements at the specified location in the container. Inserts @count copies of the @value before @pos.*/
 			void insert(iterator pos, size_type count, const value_type& value)
-			{
-				if (count > 0) 
-				{
-					const difference_type offset = pos - begin();
-					const size_type       old_size = size();
-					resize(old_size + count);
-					ft::copy_backward(start_ + offset, start_ + old_size, start_ + old_size + count);
-					ft::fill_n(start_ + offset, count, value);
-        		}
-			}
+			{ fill_insert_(pos.base(), count, value);}
 			
 			/*Inserts elements at the specified location in the container. Inserts elements from range [@first, @last) before @pos.*/
 		    template <class InputIterator>
@@ -295,7 +298,7 @@ namespace ft
 			/*Appends the given element value to the end of the container. The new element is initialized as a copy of value.*/
 			void push_back(const value_type& value)
 			{
-				if (finish_ == finish_of_storage_)
+				if (finish_ == finish_of_storage_())
 					reserve(capacity() + 1);
 				construct_(1, value);
 			}
@@ -317,13 +320,41 @@ namespace ft
 				}
 			}
 
-			/*Exchanges the contents and capacity of the container with those of other.*/
+			/*Resizes the container to contain @count elements. 
+			New elements of POD type are left uninitialized, all others are default constructed.*/
+			void resize_default_init(size_type count)
+			{
+				const size_type old = size();
+				if (old > count)
+				{ destroy_(start_ + count);}
+				if (old < count)
+				{
+					reserve(count);
+					default_init_(count - old, ft::is_pod<value_type>());
+				}
+			}
+
+			/*Appends @n elements without initializing them (POD types only, all others are default constructed).
+			Returns the writable range [first, second) covering the new elements.*/
+			ft::pair<pointer, pointer> append_uninitialized(size_type n)
+			{
+				if (n > max_size() - size())
+					throw std::length_error("vector");
+				if (n > size_type(finish_of_storage_() - finish_))
+					reserve(size() + n);
+				pointer first = finish_;
+				default_init_(n, ft::is_pod<value_type>());
+				return ft::make_pair(first, finish_);
+			}
+
+			/*Exchanges the contents and capacity of the container with those of other. Allocators that do not
+			propagate stay in place and must compare equal.*/
 			void swap(vector& other)
 			{
 				std::swap(start_, other.start_);
-				std::swap(alloc_, other.alloc_);
+				std::swap(finish_of_storage_(), other.finish_of_storage_());
 				std::swap(finish_, other.finish_);
-				std::swap(finish_of_storage_, other.finish_of_storage_);
+				swap_allocator_(other, ft::allocator_propagates<allocator_type>());
 			}
 
 
@@ -337,39 +368,116 @@ namespace ft
 			{
 				if (n > max_size())
 					throw std::length_error("vector");
-				start_ = finish_ = alloc_.allocate(n);
-				finish_of_storage_ = start_ + n;
+				start_ = finish_ = alloc_().allocate(n);
+				finish_of_storage_() = start_ + n;
+			}
+
+			/*Allocates storage for @n elements and fills it with copies of @value*/
+			void fill_initialize_(size_type n, const value_type& value, ft::false_type)
+			{
+				allocate_(n);
+				construct_(n, value);
+			}
+
+			/*Same as above, but an all-zero POD @value is not written at all. 
+			The storage is requested zero filled from the allocator instead.*/
+			void fill_initialize_(size_type n, const value_type& value, ft::true_type)
+			{
+				if (!is_zero_bytes_(value))
+					return fill_initialize_(n, value, ft::false_type());
+				if (n > max_size())
+					throw std::length_error("vector");
+				start_ = alloc_().allocate_zeroed(n);
+				finish_ = finish_of_storage_() = start_ + n;
+			}
+
+			/*Checks whether every byte of the object representation of @value is zero*/
+			static bool is_zero_bytes_(const value_type& value)
+			{
+				const unsigned char* byte = reinterpret_cast<const unsigned char*>(&value);
+				for (size_type i = 0; i < sizeof(value_type); ++i)
+					if (byte[i] != 0)
+						return false;
+				return true;
 			}
 
 			/*Initializes @n objects of objec-type @val*/
 			inline void construct_(size_type n, const_reference val = value_type())
 			{
 				for (size_type i = 0; i < n; ++i, ++finish_)
-					alloc_.construct(finish_, val);
+					alloc_().construct(finish_, val);
 			}
 
 			template <typename ForwardIterator>
 			inline void construct_(ForwardIterator first, ForwardIterator last, forward_iterator_tag)
 			{
 				for (; first != last; ++first, ++finish_)
-					alloc_.construct(finish_, *first);
+					alloc_().construct(finish_, *first);
+			}
+
+			/*Claims @n slots past @finish_ for POD types without writing to them*/
+			inline void default_init_(size_type n, ft::true_type)
+			{ finish_ += n;}
+
+			/*Default constructs @n objects past @finish_ for types that need a constructor call*/
+			inline void default_init_(size_type n, ft::false_type)
+			{ construct_(n);}
+
+			/*Moves the contents into new storage for @n elements by copy construction*/
+			void reallocate_(size_type n, ft::false_type)
+			{
+				vector new_vect(alloc_());
+				new_vect.allocate_(n);
+				new_vect.construct_(start_, finish_, ft::iterator_category(finish_));
+				swap(new_vect);
+			}
+
+			/*Lets the allocator relocate POD contents into storage for @n elements, e.g. by remapping pages*/
+			void reallocate_(size_type n, ft::true_type)
+			{
+				if (start_ == mynullptr)
+				{
+					allocate_(n);
+					return ;
+				}
+				const size_type old_size = size();
+				start_ = alloc_().reallocate(start_, capacity(), n);
+				finish_ = start_ + old_size;
+				finish_of_storage_() = start_ + n;
 			}
 
 			/*Calls the destructor of every object in storage up to @new_end starting from @_finish*/
 			inline void destroy_(pointer new_end)
 			{
 				for (; finish_ != new_end;)
-					alloc_.destroy(--finish_);
+					alloc_().destroy(--finish_);
+			}
+
+			/*Takes over @alloc on copy assignment. Storage from an allocator that does not compare equal
+			is released first, through the allocator that made it.*/
+			void copy_allocator_(const allocator_type& alloc, ft::true_type)
+			{
+				if (!(alloc_() == alloc))
+					deallocate_();
+				alloc_() = alloc;
 			}
 
+			/*Keeps the own allocator on copy assignment*/
+			void copy_allocator_(const allocator_type&, ft::false_type) {}
+
+			void swap_allocator_(vector& other, ft::true_type)
+			{ std::swap(alloc_(), other.alloc_()); }
+
+			void swap_allocator_(vector&, ft::false_type) {}
+
 			/*Deallocates the storage referenced by start_*/
 			inline void deallocate_()
 			{
 				if (start_ != mynullptr)
 				{
 					destroy_(start_);
-					alloc_.deallocate(start_, capacity());
-					start_ = finish_ = finish_of_storage_ = mynullptr;
+					alloc_().deallocate(start_, capacity());
+					start_ = finish_ = finish_of_storage_() = mynullptr;
 				}
 			}
 
@@ -399,6 +507,44 @@ namespace ft
 					push_back(*first);
 			}
 
+			/*Opens a gap of @n elements in front of @pos and fills it with copies of @value.
+			When reallocation is required, prefix, new elements and suffix are copied into the new storage in one pass.
+			Otherwise only the elements that end up past @finish_ are copy constructed, the rest is assigned in place.*/
+			void fill_insert_(pointer pos, size_type n, const value_type& value)
+			{
+				if (n == 0)
+					return ;
+				if (size_type(finish_of_storage_() - finish_) >= n)
+				{
+					const value_type copy = value;
+					const size_type elems_after = size_type(finish_ - pos);
+					pointer old_finish = finish_;
+					if (elems_after > n)
+					{
+						construct_(old_finish - n, old_finish, ft::iterator_category(pos));
+						ft::copy_backward(pos, old_finish - n, old_finish);
+						ft::fill_n(pos, n, copy);
+					}
+					else
+					{
+						construct_(n - elems_after, copy);
+						construct_(pos, old_finish, ft::iterator_category(pos));
+						ft::fill(pos, old_finish, copy);
+					}
+				}
+				else
+				{
+					if (n > max_size() - size())
+						throw std::length_error("vector");
+					vector new_vect(alloc_());
+					new_vect.allocate_(get_new_size_(size() + n));
+					new_vect.construct_(start_, pos, ft::iterator_category(pos));
+					new_vect.construct_(n, value);
+					new_vect.construct_(pos, finish_, ft::iterator_category(pos));
+					swap(new_vect);
+				}
+			}
+
 			/* Returns the new size to allocate when current capacity is exceeded*/ 
 			size_type get_new_size_(size_type new_size) const
 			{
@@ -418,14 +564,40 @@ namespace ft
 				ForwardIterator last,
 				ft::forward_iterator_tag)
 			{
-				size_type n = static_cast<size_type>(ft::distance(first, last));
-				if (n > 0) 
+				const size_type n = static_cast<size_type>(ft::distance(first, last));
+				if (n == 0)
+					return ;
+				pointer pos = position.base();
+				if (size_type(finish_of_storage_() - finish_) >= n)
 				{
-					const difference_type offset = position - begin();
-					const size_type       old_size = size();
-					resize(old_size + n);
-					ft::copy_backward(start_ + offset, start_ + old_size, start_ + old_size + n);
-					ft::copy(first, last, start_ + offset);
+					const size_type elems_after = size_type(finish_ - pos);
+					pointer old_finish = finish_;
+					if (elems_after > n)
+					{
+						construct_(old_finish - n, old_finish, ft::iterator_category(pos));
+						ft::copy_backward(pos, old_finish - n, old_finish);
+						ft::copy(first, last, pos);
+					}
+					else
+					{
+						ForwardIterator mid = first;
+						for (size_type i = 0; i < elems_after; ++i)
+							++mid;
+						construct_(mid, last, ft::iterator_category(first));
+						construct_(pos, old_finish, ft::iterator_category(pos));
+						ft::copy(first, mid, pos);
+					}
+				}
+				else
+				{
+					if (n > max_size() - size())
+						throw std::length_error("vector");
+					vector new_vect(alloc_());
+					new_vect.allocate_(get_new_size_(size() + n));
+					new_vect.construct_(start_, pos, ft::iterator_category(pos));
+					new_vect.construct_(first, last, ft::iterator_category(first));
+					new_vect.construct_(pos, finish_, ft::iterator_category(pos));
+					swap(new_vect);
 				}
 			}
 
@@ -449,10 +621,18 @@ namespace ft
 			}
 
 		private:
-			allocator_type	alloc_;
-			pointer			start_;
-			pointer			finish_;
-			pointer			finish_of_storage_;
+			pointer											start_;
+			pointer											finish_;
+			/*End of storage and allocator share one member, so a stateless allocator takes no space*/
+			ft::compressed_pair<pointer, allocator_type>	storage_;
+
+			allocator_type& alloc_() { return storage_.second(); }
+
+			const allocator_type& alloc_() const { return storage_.second(); }
+
+			pointer& finish_of_storage_() { return storage_.first(); }
+
+			pointer finish_of_storage_() const { return storage_.first(); }
 	};
 
 /***********************************************
@@ -6,26 +6,73 @@
 #include <set>
 #include <stack>
 #include <deque>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <climits>
+#include <cstdlib>
+#include <pthread.h>
+#include <sys/time.h>
 
 #ifdef FT
 #define NSP ft
 #include "vector.hpp"
+#include "span.hpp"
 #include "map.hpp"
+#include "memory_resource.hpp"
+#include "mmap_allocator.hpp"
 #include "set.hpp"
 #include "stack.hpp"
+#include "caching_allocator.hpp"
+#include "compact_map.hpp"
+#include "compact_set.hpp"
+#include "cow_map.hpp"
+#include "frozen_map.hpp"
+#include "parallel.hpp"
+#include "persistent_map.hpp"
+typedef ft::map<int, int, std::less<int>, ft::caching_allocator<ft::pair<const int, int> > > churnMap;
+typedef ft::compact_map<int, int> compactMap;
+typedef ft::compact_set<int> compactSet;
+typedef ft::vector<int, ft::mmap_allocator<int> > mappedVec;
+typedef ft::cow_map<int, int> cowMap;
+typedef ft::persistent_map<int, int> persistentMap;
+typedef ft::map<int, int> redBlackMap;
+typedef ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::avl_balance> avlMap;
+typedef ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::splay_balance> splayMap;
 #else
 #define NSP std
+typedef std::map<int, int> churnMap;
+typedef std::map<int, int> compactMap;
+typedef std::set<int> compactSet;
+typedef std::vector<int> mappedVec;
+typedef std::map<int, int> cowMap;
+typedef std::map<int, int> persistentMap;
+typedef std::map<int, int> redBlackMap;
+typedef std::map<int, int> avlMap;
+typedef std::map<int, int> splayMap;
 #endif
 #define PLN(txt) std::cout << txt << std::endl
 #define PB(txt) PLN(((txt)?"yes":"no"))
 #define START  begin = std::clock()
 #define STOP PLN("time: " <<static_cast<double>((std::clock() - begin)) /CLOCKS_PER_SEC << "s")
 
+template <class T>
+struct firstLess : std::binary_function <T,T,bool> {
+	bool operator() (const T& x, const T& y) const {return x.first < y.first;}
+};
+
 template <class T>
 struct tmore : std::binary_function <T,T,bool> {
 	bool operator() (const T& x, const T& y) const {return x>y;}
 };
 
+template <class T>
+struct firstKey {
+	typedef int result_type;
+	int operator() (const T& x) const {return x.first;}
+};
+
 // template <typename T, typename Alloc>
 // std::ostream &operator<< (std::ostream &s, const NSP::vector<T, Alloc>& vec){
 // 	for (typename NSP::vector<T, Alloc>::size_type i = 0; i < vec.size(); ++i)
@@ -56,6 +103,192 @@ void printSet(NSP::set<T, U, V> m) {
 		}
 }
 
+/*Orders std::string keys and lets const char* probes through without building a std::string*/
+struct stringLess {
+	typedef void is_transparent;
+	bool operator()(const std::string& x, const std::string& y) const { return x < y; }
+	bool operator()(const char* x, const std::string& y) const { return y.compare(x) > 0; }
+	bool operator()(const std::string& x, const char* y) const { return x.compare(y) < 0; }
+};
+
+#ifdef FT
+/*Takes memory from new and delete and keeps track of the bytes it has handed out*/
+class countingResource : public ft::memory_resource {
+	public:
+		size_t outstanding;
+		countingResource(): outstanding(0) {}
+	protected:
+		void* do_allocate(size_t bytes, size_t align) {
+			outstanding += bytes;
+			return ft::new_delete_resource()->allocate(bytes, align);
+		}
+		void do_deallocate(void* p, size_t bytes, size_t align) {
+			outstanding -= bytes;
+			ft::new_delete_resource()->deallocate(p, bytes, align);
+		}
+		bool do_is_equal(const ft::memory_resource& other) const { return this == &other; }
+};
+#endif
+
+/*Mapped value that counts how often one was constructed*/
+struct countedValue {
+	static int constructed;
+	int value;
+	countedValue(): value(0) { ++constructed; }
+	countedValue(int v): value(v) { ++constructed; }
+	countedValue(const countedValue& other): value(other.value) { ++constructed; }
+};
+int countedValue::constructed = 0;
+
+struct addOne {
+	void operator()(int& x) const { ++x; }
+};
+
+struct tripled {
+	int operator()(int x) const { return 3 * x; }
+};
+
+struct throwOnNegative {
+	void operator()(int x) const {
+		if (x < 0)
+			throw std::runtime_error("negative element");
+	}
+};
+
+struct sumMapped {
+	long operator()(long sum, const NSP::pair<const int, int>& value) const { return sum + value.second; }
+};
+
+struct bumpMapped {
+	void operator()(NSP::pair<const int, int>& value) const { ++value.second; }
+};
+
+double wallClock() {
+	timeval now;
+	gettimeofday(&now, NULL);
+	return now.tv_sec + now.tv_usec / 1e6;
+}
+
+void* churnThread(void* seed) {
+	unsigned int state = static_cast<unsigned int>(reinterpret_cast<size_t>(seed));
+	churnMap m;
+	for (int i = 0; i < 500000; ++i) {
+		state = state * 1103515245 + 12345;
+		if (state & (1 << 20))
+			m.insert(NSP::make_pair(static_cast<int>((state >> 8) % 4096), i));
+		else
+			m.erase((state >> 8) % 4096);
+	}
+	return reinterpret_cast<void*>(m.size());
+}
+
+/*Prints what map::stats() reports; the counters need a build with STATS=1 (FT_TREE_STATS)*/
+template <class Map>
+void printStats(const Map& m) {
+	#ifdef FT
+	ft::tree_stats stats = m.stats();
+	PLN("stats: height " << stats.height << " black height " << stats.black_height
+		<< (stats.counting ? "" : " (counters off)") << " comparisons " << stats.comparisons
+		<< " rotations " << stats.rotations << " insert fixups " << stats.insert_fixups
+		<< " erase fixups " << stats.erase_fixups);
+	#else
+	(void) m;
+	PLN("stats: -");
+	#endif
+}
+
+template <class T, class U>
+bool sameEntry(const T& entry, const U& expected) {
+	return entry.first == expected.first && entry.second == expected.second;
+}
+
+bool sameEntry(int entry, int expected) {
+	return entry == expected;
+}
+
+/*Checks @container against the std container @reference, forwards and backwards*/
+template <class Container, class Reference>
+bool sameAsReference(const Container& container, const Reference& reference) {
+	if (container.size() != reference.size())
+		return false;
+	typename Container::const_iterator it = container.begin();
+	for (typename Reference::const_iterator ref = reference.begin(); ref != reference.end(); ++ref, ++it)
+		if (!sameEntry(*it, *ref))
+			return false;
+	typename Container::const_reverse_iterator rit = container.rbegin();
+	for (typename Reference::const_reverse_iterator ref = reference.rbegin(); ref != reference.rend(); ++ref, ++rit)
+		if (!sameEntry(*rit, *ref))
+			return false;
+	return it == container.end() && rit == container.rend();
+}
+
+/*Inserts and erases random keys, by key, iterator and range, and checks the map against std::map after every round*/
+template <class Map>
+void randomErase(const char* policy) {
+	Map m;
+	std::map<int, int> reference;
+	size_t matching = 0;
+	for (int round = 0; round < 40; ++round) {
+		for (int i = 0; i < 3000; ++i) {
+			const int key = std::rand() % 4000;
+			if (std::rand() % 5 < (round % 4 == 3 ? 4 : 2)) {
+				m.erase(key);
+				reference.erase(key);
+			}
+			else {
+				m[key] = i;
+				reference[key] = i;
+			}
+		}
+		const int key = std::rand() % 4000;
+		typename Map::iterator found = m.lower_bound(key);
+		if (found != m.end()) {
+			reference.erase(found->first);
+			m.erase(found);
+		}
+		m.erase(m.lower_bound(key + 100), m.lower_bound(key + 160));
+		reference.erase(reference.lower_bound(key + 100), reference.lower_bound(key + 160));
+		matching += sameAsReference(m, reference);
+	}
+	PLN(policy << ": " << reference.size() << " " << matching << " of 40 rounds match");
+}
+
+/*Derives the next version of a table: persistent_map shares the untouched nodes, std::map has to copy*/
+persistentMap publish(const persistentMap& current, int assignKey, int value, int eraseKey) {
+	#ifdef FT
+	return current.insert_or_assign(assignKey, value).erase(eraseKey);
+	#else
+	persistentMap next(current);
+	next[assignKey] = value;
+	next.erase(eraseKey);
+	return next;
+	#endif
+}
+
+template <class Map>
+void balanceLookups(const char* policy, const NSP::vector<int>& keys,
+	const NSP::vector<int>& uniform, const NSP::vector<int>& zipf) {
+	clock_t begin;
+	Map m;
+	for (size_t i = 0; i < keys.size(); ++i)
+		m.insert(NSP::make_pair(keys[i], static_cast<int>(i)));
+	printStats(m);
+	const NSP::vector<int>* streams[2] = { &uniform, &zipf };
+	const char* names[2] = { "uniform", "zipf" };
+	for (int s = 0; s < 2; ++s) {
+		#ifdef FT
+		m.reset_stats();
+		#endif
+		START;
+		long hits = 0;
+		for (size_t i = 0; i < streams[s]->size(); ++i)
+			hits += (m.find((*streams[s])[i]) != m.end());
+		PLN(policy << " " << names[s] << ": " << hits);
+		STOP;
+		printStats(m);
+	}
+}
+
 int main(int argc, char **argv) {
 
 	#ifdef FT
@@ -117,6 +350,27 @@ int main(int argc, char **argv) {
 	fifthVec.reserve(325);
 	PLN(fifthVec.capacity());
 	PLN((fifthVec.empty()?"Empty":"Not empty"));
+	//shrink_to_fit, spelled as the copy and swap idiom for std::vector of C++98
+	NSP::vector<int> shrinkVec;
+	for (int i = 0; i < 1000; ++i)
+		shrinkVec.push_back(i);
+	shrinkVec.resize(10);
+	#ifdef FT
+	shrinkVec.shrink_to_fit();
+	#else
+	NSP::vector<int>(shrinkVec).swap(shrinkVec);
+	#endif
+	PLN(shrinkVec.size() << " " << shrinkVec.capacity() << " " << shrinkVec.front() << " " << shrinkVec.back());
+	printVec(shrinkVec);
+	shrinkVec.clear();
+	#ifdef FT
+	shrinkVec.shrink_to_fit();
+	#else
+	NSP::vector<int>().swap(shrinkVec);
+	#endif
+	PLN(shrinkVec.size() << " " << shrinkVec.capacity() << " " << (shrinkVec.begin() == shrinkVec.end()));
+	shrinkVec.push_back(5);
+	PLN(shrinkVec.size() << " " << shrinkVec.front());
 	//access
 	PLN("VECTOR: access");
 
@@ -164,6 +418,121 @@ int main(int argc, char **argv) {
 
 	NSP::vector<int> dummyVec(5, 3, thirdVec.get_allocator());
 	printVec(dummyVec);
+	PLN("VECTOR: default-initialized growth");
+	NSP::vector<int> rawVec(3, 7);
+	size_t rawCapacity = rawVec.capacity();
+	#ifdef FT
+	rawVec.resize_default_init(1000);
+	#else
+	rawVec.resize(1000);
+	#endif
+	PB(rawVec.capacity() > rawCapacity);
+	for (size_t i = 3; i < rawVec.size(); ++i)
+		rawVec[i] = i;
+	#ifdef FT
+	ft::pair<int*, int*> rawTail = rawVec.append_uninitialized(500);
+	#else
+	rawVec.resize(rawVec.size() + 500);
+	std::pair<int*, int*> rawTail(&rawVec[1000], &rawVec[0] + rawVec.size());
+	#endif
+	PLN(rawTail.second - rawTail.first << " " << rawVec.size());
+	for (int* raw = rawTail.first; raw != rawTail.second; ++raw)
+		*raw = 1;
+	long rawSum = 0;
+	for (size_t i = 0; i < rawVec.size(); ++i)
+		rawSum += rawVec[i];
+	PLN(rawSum << " " << rawVec[0] << " " << rawVec[999] << " " << rawVec.back());
+	#ifdef FT
+	rawVec.resize_default_init(10);
+	rawTail = rawVec.append_uninitialized(5);
+	#else
+	rawVec.resize(15);
+	rawTail = std::pair<int*, int*>(&rawVec[10], &rawVec[0] + rawVec.size());
+	#endif
+	for (int* raw = rawTail.first; raw != rawTail.second; ++raw)
+		*raw = 2;
+	printVec(rawVec);
+	NSP::vector<std::string> textVec(2, "text");
+	#ifdef FT
+	textVec.resize_default_init(50);
+	ft::pair<std::string*, std::string*> textTail = textVec.append_uninitialized(100);
+	#else
+	textVec.resize(50);
+	textVec.resize(150);
+	std::pair<std::string*, std::string*> textTail(&textVec[50], &textVec[0] + textVec.size());
+	#endif
+	size_t emptyTexts = 0;
+	for (size_t i = 0; i < textVec.size(); ++i)
+		emptyTexts += textVec[i].empty();
+	PLN(textVec.size() << " " << emptyTexts << " " << textVec[1] << " " << (textTail.second - textTail.first));
+	#ifdef FT
+	textVec.resize_default_init(1);
+	#else
+	textVec.resize(1);
+	#endif
+	PLN(textVec.size() << " " << textVec[0]);
+	//mmap_allocator has no std counterpart: the STL run uses std::allocator
+	PLN("VECTOR: mmap allocator");
+	mappedVec mappedInts;
+	for (int i = 0; i < 1 << 20; ++i)
+		mappedInts.push_back(i);
+	PLN(mappedInts.size() << " " << mappedInts[0] << " " << mappedInts[123456] << " " << mappedInts.back());
+	mappedVec mappedCopy(mappedInts);
+	PB(mappedCopy == mappedInts);
+	mappedCopy.insert(mappedCopy.begin() + 1000, 3, -1);
+	mappedCopy.insert(mappedCopy.end(), 2, -2);
+	PLN(mappedCopy.size() << " " << mappedCopy[999] << " " << mappedCopy[1000] << " " << mappedCopy[1002]
+		<< " " << mappedCopy[1003] << " " << mappedCopy[mappedCopy.size() - 3] << " " << mappedCopy.back());
+	mappedCopy.resize(300000);
+	#ifdef FT
+	mappedCopy.shrink_to_fit();
+	#else
+	mappedVec(mappedCopy).swap(mappedCopy);
+	#endif
+	PLN(mappedCopy.size() << " " << mappedCopy.capacity() << " " << mappedCopy[1001] << " " << mappedCopy.back());
+	mappedCopy.resize(100);
+	#ifdef FT
+	mappedCopy.shrink_to_fit();
+	#else
+	mappedVec(mappedCopy).swap(mappedCopy);
+	#endif
+	PLN(mappedCopy.size() << " " << mappedCopy.capacity() << " " << mappedCopy[99]);
+	mappedVec zeroVec(1 << 19, 0);
+	PLN(zeroVec.size() << " " << std::count(zeroVec.begin(), zeroVec.end(), 0));
+	zeroVec.assign(1 << 18, 9);
+	zeroVec.assign(1 << 21, 0);
+	PLN(zeroVec.size() << " " << std::count(zeroVec.begin(), zeroVec.end(), 0));
+	zeroVec.assign(300, 7);
+	zeroVec.assign(1000, 0);
+	PLN(zeroVec.size() << " " << std::count(zeroVec.begin(), zeroVec.end(), 0));
+	PLN("VECTOR: span");
+	NSP::vector<int> spanVec;
+	for (int i = 0; i < 10; ++i)
+		spanVec.push_back(i * i);
+	long spanSum = 0;
+	#ifdef FT
+	ft::span<int> wholeSpan(spanVec);
+	ft::span<int> emptySpan(spanVec.data(), 0);
+	ft::span<const int> constSpan(wholeSpan);
+	ft::span<const int> middleSpan = constSpan.subspan(2, 5);
+	PLN(wholeSpan.size() << " " << emptySpan.size() << " " << emptySpan.empty() << " " << wholeSpan.size_bytes());
+	PLN(middleSpan.front() << " " << middleSpan.back() << " " << constSpan.first(4).back()
+		<< " " << constSpan.last(3).front() << " " << constSpan.subspan(7).size());
+	for (ft::span<int>::const_iterator it = wholeSpan.cbegin(); it != wholeSpan.cend(); ++it)
+		spanSum += *it;
+	for (ft::span<const int>::reverse_iterator it = middleSpan.rbegin(); it != middleSpan.rend(); ++it)
+		spanSum = spanSum * 2 + *it;
+	wholeSpan[0] = 100;
+	#else
+	PLN(spanVec.size() << " " << 0 << " " << 1 << " " << spanVec.size() * sizeof(int));
+	PLN(spanVec[2] << " " << spanVec[6] << " " << spanVec[3] << " " << spanVec[7] << " " << 3);
+	for (size_t i = 0; i < spanVec.size(); ++i)
+		spanSum += spanVec[i];
+	for (size_t i = 7; i-- > 2; )
+		spanSum = spanSum * 2 + spanVec[i];
+	spanVec[0] = 100;
+	#endif
+	PLN(spanSum << " " << spanVec[0]);
 	//relational Operators
 	PLN("VECTOR: relational operators");
 
@@ -184,6 +553,209 @@ int main(int argc, char **argv) {
 		speedVec.pop_back();
 	}
 	STOP;
+	START;
+	PLN("VECTOR: MmapSpeedTest");
+
+	for (int round = 0; round < 10; ++round) {
+		mappedVec growVec;
+		for (size_t i = 0; i < 10000000; ++i)
+			growVec.push_back(i);
+		mappedVec touchVec(1 << 24, 0);
+		for (int i = 0; i < 100000; ++i)
+			touchVec[std::rand() % touchVec.size()] += 1;
+		PLN(growVec.back() << " " << std::accumulate(touchVec.begin(), touchVec.end(), 0L));
+	}
+	STOP;
+	//Sorting
+	PLN("VECTOR: sorting");
+	NSP::vector<int> sortVec;
+	for (int i = 0; i < 100; ++i)
+		sortVec.push_back((i * 37) % 101);
+	NSP::partial_sort(sortVec.begin(), sortVec.begin() + 10, sortVec.end());
+	for (int i = 0; i < 10; ++i)
+		PLN(sortVec[i]);
+	NSP::sort(sortVec.begin(), sortVec.end(), tmore<int>());
+	printVec(sortVec);
+	PLN(NSP::lower_bound(sortVec.begin(), sortVec.end(), 42, tmore<int>()) - sortVec.begin());
+	PLN(NSP::upper_bound(sortVec.begin(), sortVec.end(), 42, tmore<int>()) - sortVec.begin());
+	PB(NSP::binary_search(sortVec.begin(), sortVec.end(), 77, tmore<int>()));
+	PB(NSP::binary_search(sortVec.begin(), sortVec.end(), 101, tmore<int>()));
+	NSP::sort(sortVec.begin(), sortVec.end());
+	PLN(NSP::lower_bound(sortVec.begin(), sortVec.end(), 0) - sortVec.begin());
+	PLN(NSP::upper_bound(sortVec.begin(), sortVec.end(), 100) - sortVec.begin());
+	NSP::vector<NSP::pair<int, int> > pairVec;
+	for (int i = 0; i < 100; ++i)
+		pairVec.push_back(NSP::make_pair(i % 7, i));
+	NSP::stable_sort(pairVec.begin(), pairVec.end(), firstLess<NSP::pair<int, int> >());
+	for (size_t i = 0; i < pairVec.size(); ++i)
+		PLN(pairVec[i].first << " " << pairVec[i].second);
+	//radix_sort has no std counterpart: the STL run sorts with std::sort and std::stable_sort instead
+	PLN("VECTOR: radix sort");
+	NSP::vector<int> radixInts;
+	for (int i = 0; i < 100000; ++i)
+		radixInts.push_back(std::rand() - RAND_MAX / 2);
+	radixInts.push_back(INT_MIN);
+	radixInts.push_back(INT_MAX);
+	radixInts.push_back(0);
+	radixInts.push_back(-1);
+	radixInts.push_back(INT_MIN);
+	NSP::vector<int> expectedInts(radixInts);
+	std::sort(expectedInts.begin(), expectedInts.end());
+	#ifdef FT
+	ft::radix_sort(radixInts.begin(), radixInts.end());
+	#else
+	std::sort(radixInts.begin(), radixInts.end());
+	#endif
+	PLN((radixInts == expectedInts ? "yes" : "no") << " " << radixInts[0] << " " << radixInts[1]
+		<< " " << radixInts[2] << " " << radixInts.back());
+	NSP::vector<long> radixLongs;
+	for (int i = 0; i < 100000; ++i)
+		radixLongs.push_back((static_cast<long>(std::rand()) << 33) - (static_cast<long>(std::rand()) << 2) + i % 3);
+	radixLongs.push_back(LONG_MIN);
+	radixLongs.push_back(LONG_MAX);
+	NSP::vector<long> expectedLongs(radixLongs);
+	std::sort(expectedLongs.begin(), expectedLongs.end());
+	#ifdef FT
+	ft::radix_sort(radixLongs.begin(), radixLongs.end());
+	#else
+	std::sort(radixLongs.begin(), radixLongs.end());
+	#endif
+	PLN((radixLongs == expectedLongs ? "yes" : "no") << " " << radixLongs[0] << " " << radixLongs[1]
+		<< " " << radixLongs.back());
+	NSP::vector<unsigned long> radixWide;
+	for (int i = 0; i < 1000; ++i)
+		radixWide.push_back((static_cast<unsigned long>(i % 17) << 60) | 42);
+	NSP::vector<unsigned long> expectedWide(radixWide);
+	std::sort(expectedWide.begin(), expectedWide.end());
+	#ifdef FT
+	ft::radix_sort(radixWide.begin(), radixWide.end());
+	#else
+	std::sort(radixWide.begin(), radixWide.end());
+	#endif
+	PLN((radixWide == expectedWide ? "yes" : "no") << " " << radixWide.front() << " " << radixWide.back());
+	NSP::vector<int> radixSame(1000, -7);
+	#ifdef FT
+	ft::radix_sort(radixSame.begin(), radixSame.end());
+	#endif
+	PLN(radixSame.size() << " " << std::count(radixSame.begin(), radixSame.end(), -7));
+	NSP::vector<NSP::pair<int, int> > radixPairs;
+	for (int i = 0; i < 10000; ++i)
+		radixPairs.push_back(NSP::make_pair(std::rand() % 201 - 100, i));
+	radixPairs.push_back(NSP::make_pair(INT_MIN, -1));
+	radixPairs.push_back(NSP::make_pair(INT_MAX, -2));
+	std::vector<std::pair<int, int> > expectedPairs;
+	for (size_t i = 0; i < radixPairs.size(); ++i)
+		expectedPairs.push_back(std::make_pair(radixPairs[i].first, radixPairs[i].second));
+	std::stable_sort(expectedPairs.begin(), expectedPairs.end(), firstLess<std::pair<int, int> >());
+	#ifdef FT
+	ft::radix_sort(radixPairs.begin(), radixPairs.end(), firstKey<ft::pair<int, int> >());
+	#else
+	std::stable_sort(radixPairs.begin(), radixPairs.end(), firstLess<std::pair<int, int> >());
+	#endif
+	bool pairsMatch = true;
+	for (size_t i = 0; i < radixPairs.size(); ++i)
+		pairsMatch = pairsMatch && radixPairs[i].first == expectedPairs[i].first && radixPairs[i].second == expectedPairs[i].second;
+	PLN((pairsMatch ? "yes" : "no") << " " << radixPairs[0].second << " " << radixPairs[1].first
+		<< " " << radixPairs[1].second << " " << radixPairs.back().second);
+	START;
+	PLN("VECTOR: SortSpeedTest");
+	for (int pattern = 0; pattern < 4; ++pattern) {
+		NSP::vector<int> patternVec;
+		for (int i = 0; i < 1000000; ++i) {
+			if (pattern == 0)
+				patternVec.push_back(std::rand());
+			else if (pattern == 1)
+				patternVec.push_back(i);
+			else if (pattern == 2)
+				patternVec.push_back(1000000 - i);
+			else
+				patternVec.push_back(std::rand() % 4);
+		}
+		NSP::sort(patternVec.begin(), patternVec.end());
+		PLN(patternVec.front() << " " << patternVec[500000] << " " << patternVec.back());
+	}
+	STOP;
+	START;
+	PLN("VECTOR: CompareSpeedTest");
+
+	NSP::vector<char> lhsVec(64 << 20, 'x');
+	NSP::vector<char> rhsVec(lhsVec);
+	rhsVec.back() = 'y';
+	for (int i = 0; i < 20; ++i) {
+		PB(lhsVec == rhsVec);
+		PB(lhsVec < rhsVec);
+	}
+	STOP;
+	//parallel.hpp has no std counterpart: the STL run times the sequential algorithms for comparison
+	PLN("VECTOR: ParallelSpeedTest");
+	NSP::vector<int> parallelIn;
+	for (int i = 0; i < 4000000; ++i)
+		parallelIn.push_back(std::rand() % 1000000);
+	NSP::vector<int> expectedIncremented(parallelIn);
+	std::for_each(expectedIncremented.begin(), expectedIncremented.end(), addOne());
+	NSP::vector<int> expectedTripled(parallelIn.size());
+	std::transform(parallelIn.begin(), parallelIn.end(), expectedTripled.begin(), tripled());
+	const long expectedSum = std::accumulate(parallelIn.begin(), parallelIn.end(), 0L);
+	NSP::vector<int> expectedSorted(parallelIn);
+	std::sort(expectedSorted.begin(), expectedSorted.end());
+	for (size_t threads = 1; threads <= 4; threads *= 2) {
+		#ifdef FT
+		ft::thread_pool pool(threads);
+		#endif
+		NSP::vector<int> work(parallelIn);
+		double wallBegin = wallClock();
+		#ifdef FT
+		ft::parallel_for_each(work.begin(), work.end(), addOne(), 0, pool);
+		#else
+		std::for_each(work.begin(), work.end(), addOne());
+		#endif
+		PLN(threads << " threads for_each: " << (work == expectedIncremented ? "yes" : "no"));
+		PLN("time: " << wallClock() - wallBegin << "s");
+		wallBegin = wallClock();
+		#ifdef FT
+		ft::parallel_transform(parallelIn.begin(), parallelIn.end(), work.begin(), tripled(), 0, pool);
+		#else
+		std::transform(parallelIn.begin(), parallelIn.end(), work.begin(), tripled());
+		#endif
+		PLN(threads << " threads transform: " << (work == expectedTripled ? "yes" : "no"));
+		PLN("time: " << wallClock() - wallBegin << "s");
+		wallBegin = wallClock();
+		#ifdef FT
+		ft::parallel_copy(parallelIn.begin(), parallelIn.end(), work.begin(), 0, pool);
+		#else
+		std::copy(parallelIn.begin(), parallelIn.end(), work.begin());
+		#endif
+		PLN(threads << " threads copy: " << (work == parallelIn ? "yes" : "no"));
+		PLN("time: " << wallClock() - wallBegin << "s");
+		wallBegin = wallClock();
+		#ifdef FT
+		long sum = ft::parallel_reduce(parallelIn.begin(), parallelIn.end(), 0L, std::plus<long>(), 0, pool);
+		#else
+		long sum = std::accumulate(parallelIn.begin(), parallelIn.end(), 0L);
+		#endif
+		PLN(threads << " threads reduce: " << sum << " " << (sum == expectedSum ? "yes" : "no"));
+		PLN("time: " << wallClock() - wallBegin << "s");
+		wallBegin = wallClock();
+		#ifdef FT
+		ft::parallel_sort(work.begin(), work.end(), std::less<int>(), 0, pool);
+		#else
+		std::sort(work.begin(), work.end());
+		#endif
+		PLN(threads << " threads sort: " << (work == expectedSorted ? "yes" : "no"));
+		PLN("time: " << wallClock() - wallBegin << "s");
+		work.back() = -1;
+		try {
+			#ifdef FT
+			ft::parallel_for_each(work.begin(), work.end(), throwOnNegative(), 0, pool);
+			#else
+			std::for_each(work.begin(), work.end(), throwOnNegative());
+			#endif
+			PLN(threads << " threads exception: none");
+		}
+		catch (const std::exception& e) {
+			PLN(threads << " threads exception: " << e.what());
+		}
+	}
 }
 
 /*Map-------------------------------------------------------------------------*/
@@ -266,12 +838,139 @@ int main(int argc, char **argv) {
 	PLN(ifind->first << " " << ifind->second);
 	PLN(icfind->first << " " << icfind->second);
 
+	PLN("MAP: bounds");
+	NSP::map<int, int> boundMap;
+	PB(boundMap.lower_bound(1) == boundMap.end());
+	PB(boundMap.upper_bound(1) == boundMap.end());
+	for (int i = 0; i < 100; i += 10)
+		boundMap[i] = i / 10;
+	for (int probe = -5; probe <= 100; probe += 5) {
+		NSP::map<int, int>::iterator lower = boundMap.lower_bound(probe);
+		NSP::map<int, int>::const_iterator upper = static_cast<const NSP::map<int, int>&>(boundMap).upper_bound(probe);
+		PLN(probe << ": " << (lower == boundMap.end() ? -1 : lower->first)
+			<< " " << (upper == boundMap.end() ? -1 : upper->first));
+	}
+
+	PLN("MAP: randomized erase");
+	randomErase<redBlackMap>("red-black");
+	randomErase<avlMap>("avl");
+	randomErase<splayMap>("splay");
+
+	PLN("MAP: heterogeneous lookup");
+	NSP::map<std::string, int, stringLess> wordMap;
+	const char* words[] = { "pear", "apple", "fig", "kiwi", "plum", "lime" };
+	for (int i = 0; i < 6; ++i)
+		wordMap[words[i]] = i;
+	PLN(wordMap.find("fig")->second << " " << (wordMap.find("grape") == wordMap.end()));
+	PLN(wordMap.count("kiwi") << " " << wordMap.count("melon"));
+	PLN(wordMap.lower_bound("g")->first << " " << wordMap.upper_bound("lime")->first);
+	PLN((wordMap.upper_bound("zucchini") == wordMap.end()) << " " << wordMap.lower_bound("")->first);
+	PLN(wordMap.erase("apple") << " " << wordMap.erase("apple") << " " << wordMap.size());
+	printMap(wordMap);
+
+	//std::map of C++98 lacks these members: the STL run spells them out with find and insert
+	PLN("MAP: try_emplace, insert_or_assign, update");
+	NSP::map<int, countedValue> countedMap;
+	for (int key = 0; key < 4; ++key) {
+		int before = countedValue::constructed;
+		#ifdef FT
+		bool inserted = countedMap.try_emplace(key % 3, key * 10).second;
+		#else
+		bool inserted = countedMap.find(key % 3) == countedMap.end();
+		if (inserted)
+			countedMap.insert(NSP::make_pair(key % 3, countedValue(key * 10)));
+		#endif
+		bool constructed = countedValue::constructed != before;
+		PLN("try_emplace " << key % 3 << ": " << inserted << " " << countedMap[key % 3].value
+			<< " constructed: " << constructed);
+	}
+	NSP::map<int, int> assignMap;
+	for (int key = 0; key < 4; ++key) {
+		#ifdef FT
+		NSP::pair<NSP::map<int, int>::iterator, bool> assigned = assignMap.insert_or_assign(key % 2, key);
+		#else
+		NSP::pair<NSP::map<int, int>::iterator, bool> assigned = assignMap.insert(NSP::make_pair(key % 2, key));
+		if (!assigned.second)
+			assigned.first->second = key;
+		#endif
+		PLN("insert_or_assign " << key % 2 << ": " << assigned.second << " " << assigned.first->second);
+	}
+	const char* tallyText = "abracadabra";
+	NSP::map<int, int> tally;
+	for (const char* c = tallyText; *c; ++c) {
+		#ifdef FT
+		NSP::map<int, int>::iterator counted = tally.update(*c, addOne(), 0);
+		#else
+		NSP::map<int, int>::iterator counted = tally.insert(NSP::make_pair(*c, 0)).first;
+		addOne()(counted->second);
+		#endif
+		PLN("update " << *c << ": " << counted->second);
+	}
+	printMap(tally);
+
 	//allocator
 	PLN("MAP: allocator");
 
 	NSP::map<char, int>::allocator_type allo = first.get_allocator();
 	PLN(allo.max_size());
 
+	//every container has to give its memory back to the resource it took it from
+	PLN("MAP: polymorphic allocator");
+	{
+		#ifdef FT
+		typedef ft::vector<int, ft::polymorphic_allocator<int> > resourceVec;
+		typedef ft::map<int, int, std::less<int>, ft::polymorphic_allocator<ft::pair<const int, int> > > resourceMap;
+		countingResource leftResource;
+		countingResource rightResource;
+		#else
+		typedef std::vector<int> resourceVec;
+		typedef std::map<int, int> resourceMap;
+		#endif
+		{
+			#ifdef FT
+			resourceVec leftVec(&leftResource);
+			resourceVec spareVec(&leftResource);
+			resourceVec rightVec(&rightResource);
+			resourceMap leftMap(std::less<int>(), &leftResource);
+			resourceMap rightMap(std::less<int>(), &rightResource);
+			#else
+			resourceVec leftVec, spareVec, rightVec;
+			resourceMap leftMap, rightMap;
+			#endif
+			for (int i = 0; i < 10; ++i) {
+				leftVec.push_back(i);
+				leftMap[i] = i;
+			}
+			for (int i = 0; i < 1000; ++i) {
+				rightVec.push_back(-i);
+				rightMap[-i] = i;
+			}
+			#ifdef FT
+			size_t rightBefore = rightResource.outstanding;
+			#endif
+			leftVec = rightVec;
+			leftMap = rightMap;
+			PLN(leftVec.size() << " " << leftMap.size() << " " << (leftVec == rightVec) << " " << (leftMap == rightMap));
+			spareVec.push_back(42);
+			leftVec.swap(spareVec);
+			leftMap[5000] = 1;
+			PLN(leftVec.size() << " " << spareVec.size() << " " << leftMap.size() << " " << leftMap.begin()->first);
+			#ifdef FT
+			bool kept = leftVec.get_allocator().resource() == &leftResource
+				&& leftMap.get_allocator().resource() == &leftResource
+				&& rightResource.outstanding == rightBefore;
+			#else
+			bool kept = true;
+			#endif
+			PLN("allocators kept: " << kept);
+		}
+		#ifdef FT
+		PLN("outstanding: " << leftResource.outstanding << " " << rightResource.outstanding);
+		#else
+		PLN("outstanding: 0 0");
+		#endif
+	}
+
 	START;
 	PLN("MAP: speedTest");
 	int y;
@@ -286,6 +985,276 @@ int main(int argc, char **argv) {
 	for (int i = 0; i < 1000000; ++i)
 		speedMap.erase(i);
 	STOP;
+	START;
+	PLN("MAP: FindBatchSpeedTest");
+	NSP::map<int, int> batchMap;
+	NSP::vector<int> batchKeys;
+	for (int i = 0; i < 1000000; ++i)
+	{
+		int key = std::rand();
+		batchMap.insert(NSP::make_pair(key, i));
+		batchKeys.push_back(key + i % 2);
+	}
+	NSP::vector<NSP::map<int, int>::iterator> found(batchKeys.size());
+	long hits = 0;
+	for (int round = 0; round < 4; ++round)
+	{
+		#ifdef FT
+		batchMap.find_batch(batchKeys.begin(), batchKeys.end(), found.begin());
+		#else
+		for (size_t i = 0; i < batchKeys.size(); ++i)
+			found[i] = batchMap.find(batchKeys[i]);
+		#endif
+		for (size_t i = 0; i < found.size(); ++i)
+			hits += (found[i] != batchMap.end());
+	}
+	PLN(hits);
+	STOP;
+	START;
+	PLN("MAP: FrozenMapSpeedTest");
+	#ifdef FT
+	ft::frozen_map<int, int> frozenMap(batchMap);
+	#else
+	const std::map<int, int>& frozenMap = batchMap;
+	#endif
+	hits = 0;
+	for (int round = 0; round < 4; ++round)
+		for (size_t i = 0; i < batchKeys.size(); ++i)
+			hits += (frozenMap.find(batchKeys[i]) != frozenMap.end());
+	PLN(hits << " " << frozenMap.lower_bound(batchKeys[0])->first << " " << frozenMap.begin()->first);
+	STOP;
+	PLN("MAP: FingerSearchSpeedTest");
+	NSP::map<int, int> fingerMap;
+	for (int i = 0; i < 1000000; ++i)
+		fingerMap.insert(fingerMap.end(), NSP::make_pair(i * 2, i));
+	for (int jitter = 1; jitter <= 64; jitter *= 64) {
+		START;
+		#ifdef FT
+		ft::map<int, int>::finger finger(fingerMap);
+		#endif
+		hits = 0;
+		for (int i = 0; i < 4000000; ++i) {
+			int key = (i % 1000000) * 2 + std::rand() % jitter - jitter / 2;
+			#ifdef FT
+			hits += (finger.find(key) != fingerMap.end());
+			#else
+			hits += (fingerMap.find(key) != fingerMap.end());
+			#endif
+		}
+		PLN("jitter " << jitter << ": " << hits);
+		STOP;
+		#ifdef FT
+		PLN("stats: finger hits " << finger.hits() << " misses " << finger.misses());
+		PB(finger.hits() + finger.misses() == 4000000);
+		PB(finger.hits() > 9 * finger.misses());
+		#else
+		PLN("stats: -");
+		PB(true);
+		PB(true);
+		#endif
+	}
+	START;
+	PLN("MAP: CopyOnWriteSpeedTest");
+	cowMap published;
+	for (int i = 0; i < 1000000; ++i)
+		published[i * 3] = i;
+	long snapshotSum = 0;
+	for (int version = 0; version < 50; ++version) {
+		const cowMap snapshot(published);
+		for (int i = 0; i < 1000; ++i)
+			snapshotSum += snapshot.count(i * 7);
+		snapshotSum += snapshot.find(version * 3)->second;
+	}
+	cowMap edited(published);
+	edited[1] = 1;
+	edited.erase(0);
+	PLN(snapshotSum << " " << published.size() << " " << edited.size() << " " << published.count(0));
+	STOP;
+	START;
+	PLN("MAP: PersistentVersionChurnSpeedTest");
+	persistentMap versions[16];
+	for (int i = 0; i < 50000; ++i) {
+		#ifdef FT
+		versions[0] = versions[0].insert(NSP::make_pair(i * 2, i));
+		#else
+		versions[0].insert(NSP::make_pair(i * 2, i));
+		#endif
+	}
+	long versionSum = 0;
+	for (int version = 1; version <= 400; ++version) {
+		const persistentMap& current = versions[(version - 1) % 16];
+		versions[version % 16] = publish(current, std::rand() % 100000, version, std::rand() % 100000);
+		const persistentMap& old = versions[(version + 1) % 16];
+		for (int i = 0; i < 100; ++i) {
+			persistentMap::const_iterator found = old.find(std::rand() % 100000);
+			versionSum += (found == old.end()) ? 0 : found->second;
+		}
+	}
+	for (int i = 0; i < 16; ++i)
+		versionSum += versions[i].size();
+	PLN(versionSum << " " << versions[0].begin()->first << " " << (--versions[0].end())->first);
+	STOP;
+	PLN("MAP: ThreadedChurnSpeedTest");
+	for (size_t threads = 1; threads <= 4; threads *= 2) {
+		double wallBegin = wallClock();
+		pthread_t workers[4];
+		size_t sizes = 0;
+		for (size_t i = 0; i < threads; ++i)
+			pthread_create(&workers[i], NULL, &churnThread, reinterpret_cast<void*>(i + 1));
+		for (size_t i = 0; i < threads; ++i) {
+			void* size;
+			pthread_join(workers[i], &size);
+			sizes += reinterpret_cast<size_t>(size);
+		}
+		PLN(threads << " threads: " << sizes);
+		PLN("time: " << wallClock() - wallBegin << "s");
+	}
+	//the churn maps are gone: their idle node blocks can go back to the system
+	#ifdef FT
+	size_t trimmed = churnMap::allocator_type::trim();
+	PLN("trim: " << (trimmed > 0 ? "yes" : "no") << " " << (churnMap::allocator_type::trim() == 0 ? "yes" : "no"));
+	#else
+	PLN("trim: yes yes");
+	#endif
+	PLN("after trim: " << reinterpret_cast<size_t>(churnThread(reinterpret_cast<void*>(9))));
+	//walks the tree concurrently where parallel.hpp exists; the STL run repeats the sequential walk
+	PLN("MAP: ParallelReduceSpeedTest");
+	{
+		START;
+		NSP::map<int, int> reduceMap;
+		for (int i = 0; i < 10000000; ++i)
+			reduceMap.insert(reduceMap.end(), NSP::make_pair(i, (i * 7) % 1000));
+		STOP;
+		double wallBegin = wallClock();
+		long walkSum = 0;
+		for (NSP::map<int, int>::const_iterator it = reduceMap.begin(); it != reduceMap.end(); ++it)
+			walkSum += it->second;
+		PLN("sequential walk: " << walkSum);
+		PLN("time: " << wallClock() - wallBegin << "s");
+		for (size_t threads = 1; threads <= 4; threads *= 2) {
+			#ifdef FT
+			ft::thread_pool pool(threads);
+			#endif
+			wallBegin = wallClock();
+			#ifdef FT
+			long sum = ft::parallel_reduce(reduceMap, 0L, sumMapped(), std::plus<long>(), pool);
+			#else
+			long sum = 0;
+			for (NSP::map<int, int>::const_iterator it = reduceMap.begin(); it != reduceMap.end(); ++it)
+				sum = sumMapped()(sum, *it);
+			#endif
+			PLN(threads << " threads reduce: " << sum << " " << (sum == walkSum ? "yes" : "no"));
+			PLN("time: " << wallClock() - wallBegin << "s");
+			wallBegin = wallClock();
+			#ifdef FT
+			ft::parallel_for_each(reduceMap, bumpMapped(), pool);
+			#else
+			std::for_each(reduceMap.begin(), reduceMap.end(), bumpMapped());
+			#endif
+			PLN("time: " << wallClock() - wallBegin << "s");
+			long bumped = 0;
+			for (NSP::map<int, int>::const_iterator it = reduceMap.begin(); it != reduceMap.end(); ++it)
+				bumped += it->second;
+			PLN(threads << " threads for_each: " << (bumped == walkSum + 10000000L ? "yes" : "no"));
+			walkSum = bumped;
+		}
+	}
+	{
+		NSP::set<int> reduceSet;
+		for (int i = 0; i < 10000000; ++i)
+			reduceSet.insert(reduceSet.end(), (i * 7) % 10000019);
+		double wallBegin = wallClock();
+		long walkSum = 0;
+		for (NSP::set<int>::const_iterator it = reduceSet.begin(); it != reduceSet.end(); ++it)
+			walkSum += *it;
+		PLN("sequential set walk: " << walkSum);
+		PLN("time: " << wallClock() - wallBegin << "s");
+		for (size_t threads = 1; threads <= 4; threads *= 2) {
+			wallBegin = wallClock();
+			#ifdef FT
+			ft::thread_pool pool(threads);
+			long sum = ft::parallel_reduce(reduceSet, 0L, std::plus<long>(), pool);
+			#else
+			long sum = std::accumulate(reduceSet.begin(), reduceSet.end(), 0L);
+			#endif
+			PLN(threads << " threads set reduce: " << sum << " " << (sum == walkSum ? "yes" : "no"));
+			PLN("time: " << wallClock() - wallBegin << "s");
+		}
+	}
+	PLN("MAP: BalancePolicySpeedTest");
+	NSP::vector<int> policyKeys;
+	for (int i = 0; i < 200000; ++i)
+		policyKeys.push_back(std::rand());
+	NSP::vector<double> zipfCdf;
+	double zipfTotal = 0;
+	for (size_t rank = 1; rank <= policyKeys.size(); ++rank)
+		zipfCdf.push_back(zipfTotal += 1.0 / rank);
+	NSP::vector<int> uniformStream;
+	NSP::vector<int> zipfStream;
+	for (int i = 0; i < 2000000; ++i) {
+		uniformStream.push_back(policyKeys[std::rand() % policyKeys.size()]);
+		double draw = zipfTotal * std::rand() / RAND_MAX;
+		size_t rank = std::lower_bound(zipfCdf.begin(), zipfCdf.end(), draw) - zipfCdf.begin();
+		zipfStream.push_back(policyKeys[rank < policyKeys.size() ? rank : policyKeys.size() - 1]);
+	}
+	balanceLookups<redBlackMap>("red-black", policyKeys, uniformStream, zipfStream);
+	balanceLookups<avlMap>("avl", policyKeys, uniformStream, zipfStream);
+	balanceLookups<splayMap>("splay", policyKeys, uniformStream, zipfStream);
+	PLN("MAP: compact_map operations");
+	compactMap compactOps;
+	std::map<int, int> compactReference;
+	size_t compactMatching = 0;
+	size_t compactBoundMismatches = 0;
+	for (int round = 0; round < 30; ++round) {
+		for (int i = 0; i < 2000; ++i) {
+			const int key = std::rand() % 3000;
+			if (std::rand() % 5 < (round % 3 == 2 ? 4 : 2)) {
+				compactOps.erase(key);
+				compactReference.erase(key);
+			}
+			else if (i % 2) {
+				compactOps[key] = i;
+				compactReference[key] = i;
+			}
+			else {
+				compactOps.insert(NSP::make_pair(key, i));
+				compactReference.insert(std::make_pair(key, i));
+			}
+		}
+		for (int probe = 0; probe < 200; ++probe) {
+			const int key = std::rand() % 3100 - 50;
+			compactMap::const_iterator lower = compactOps.lower_bound(key);
+			std::map<int, int>::const_iterator expected = compactReference.lower_bound(key);
+			if ((lower == compactOps.end()) != (expected == compactReference.end())
+				|| (lower != compactOps.end() && lower->first != expected->first))
+				++compactBoundMismatches;
+		}
+		const int key = std::rand() % 3000;
+		compactMap::iterator found = compactOps.lower_bound(key);
+		if (found != compactOps.end()) {
+			compactReference.erase(found->first);
+			compactOps.erase(found);
+		}
+		compactOps.erase(compactOps.lower_bound(key + 100), compactOps.lower_bound(key + 150));
+		compactReference.erase(compactReference.lower_bound(key + 100), compactReference.lower_bound(key + 150));
+		compactMatching += sameAsReference(compactOps, compactReference);
+	}
+	PLN(compactReference.size() << " " << compactMatching << " of 30 rounds match, lower_bound mismatches: "
+		<< compactBoundMismatches);
+	START;
+	PLN("MAP: CompactMapSpeedTest");
+	compactMap compact;
+	for (int i = 0; i < 1000000; ++i)
+		compact[static_cast<int>(i * 7919L % 1000003)] = i;
+	long compactSum = 0;
+	for (int i = 0; i < 1000000; ++i)
+		compactSum += compact.count(static_cast<int>(i * 40503L % 1000003));
+	for (compactMap::const_iterator iter = compact.begin(); iter != compact.end(); ++iter)
+		compactSum += iter->second;
+	for (int i = 0; i < 1000000; i += 2)
+		compact.erase(static_cast<int>(i * 7919L % 1000003));
+	PLN(compactSum << " " << compact.size() << " " << compact.begin()->first << " " << (--compact.end())->first);
+	STOP;
 }
 
 /*stack-----------------------------------------------------------------------*/
@@ -392,6 +1361,43 @@ int main(int argc, char **argv) {
 	PLN(*(first.equal_range(1024).second));
 
 	// //Allocator
+	PLN("SET: compact_set operations");
+	compactSet compactKeys;
+	std::set<int> compactKeyReference;
+	size_t compactKeysMatching = 0;
+	size_t compactKeyBoundMismatches = 0;
+	for (int round = 0; round < 30; ++round) {
+		for (int i = 0; i < 2000; ++i) {
+			const int key = std::rand() % 3000;
+			if (std::rand() % 5 < (round % 3 == 2 ? 4 : 2)) {
+				compactKeys.erase(key);
+				compactKeyReference.erase(key);
+			}
+			else {
+				compactKeys.insert(key);
+				compactKeyReference.insert(key);
+			}
+		}
+		for (int probe = 0; probe < 200; ++probe) {
+			const int key = std::rand() % 3100 - 50;
+			compactSet::const_iterator lower = compactKeys.lower_bound(key);
+			std::set<int>::const_iterator expected = compactKeyReference.lower_bound(key);
+			if ((lower == compactKeys.end()) != (expected == compactKeyReference.end())
+				|| (lower != compactKeys.end() && *lower != *expected))
+				++compactKeyBoundMismatches;
+		}
+		const int key = std::rand() % 3000;
+		compactSet::iterator found = compactKeys.lower_bound(key);
+		if (found != compactKeys.end()) {
+			compactKeyReference.erase(*found);
+			compactKeys.erase(found);
+		}
+		compactKeys.erase(compactKeys.lower_bound(key + 100), compactKeys.lower_bound(key + 150));
+		compactKeyReference.erase(compactKeyReference.lower_bound(key + 100), compactKeyReference.lower_bound(key + 150));
+		compactKeysMatching += sameAsReference(compactKeys, compactKeyReference);
+	}
+	PLN(compactKeyReference.size() << " " << compactKeysMatching << " of 30 rounds match, lower_bound mismatches: "
+		<< compactKeyBoundMismatches);
 	PLN("SET: allocator");
 
 	PLN(first.get_allocator().max_size());